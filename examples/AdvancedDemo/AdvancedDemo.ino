@@ -6,7 +6,7 @@
  * - Callbacks for parameter changes
  * - Custom validation
  * - Export/import configuration
- * - Integration with existing application logic
+ * - Variables bound to parameters, kept in sync automatically
  * 
  * Based on ZONIO PWM controller firmware
  * 
@@ -103,6 +103,23 @@ void setup() {
     webConfig.addParameterToGroup("mqtt", "control_topic", "Control Topic", PARAM_TEXT, "zonio/pwm/control");
     webConfig.addParameterToGroup("mqtt", "status_topic", "Status Topic", PARAM_TEXT, "zonio/pwm/status");
     
+    // ===== BOUND VARIABLES =====
+    
+    // appConfig follows the web form, API, import and EEPROM load without copying
+    webConfig.bind("device_name", &appConfig.deviceName);
+    webConfig.bind("control_mode", &appConfig.operationMode);
+    webConfig.bind("target_temp", &appConfig.targetTemperature);
+    webConfig.bind("failsafe_temp", &appConfig.failsafeTemperature);
+    webConfig.bind("enable_logging", &appConfig.enableLogging);
+    webConfig.bind("mqtt_server", &appConfig.mqttServer);
+    webConfig.bind("mqtt_port", &appConfig.mqttPort);
+    webConfig.bind("mqtt_username", &appConfig.mqttUsername);
+    webConfig.bind("mqtt_password", &appConfig.mqttPassword);
+    webConfig.bind("min_light", &appConfig.minPWM);
+    webConfig.bind("max_light", &appConfig.maxPWM);
+    webConfig.bind("light_cycle", &appConfig.dayMode);
+    webConfig.bind("day_start_hour", &appConfig.dayStart);
+    
     // ===== CALLBACK FUNCTIONS =====
     
     // Parameter change callback
@@ -110,35 +127,28 @@ void setup() {
         Serial.printf("Parameter changed: %s = %s -> %s\n", key.c_str(), oldValue.c_str(), newValue.c_str());
         
         // Specific reactions to key changes
+        // Bound appConfig fields already hold the new value here
         if (key == "control_mode") {
-            int mode = newValue.toInt();
+            int mode = appConfig.operationMode;
             Serial.printf("Control mode changed to: %s\n", mode == 0 ? "AUTO" : mode == 1 ? "MANUAL" : "SCHEDULE");
             updateOperationMode(mode);
         }
         
         if (key == "target_temp") {
-            float temp = newValue.toFloat();
-            Serial.printf("New target temperature: %.1f°C\n", temp);
-            updateTargetTemperature(temp);
+            Serial.printf("New target temperature: %.1f°C\n", appConfig.targetTemperature);
+            updateTargetTemperature(appConfig.targetTemperature);
         }
         
         if (key == "failsafe_temp") {
-            float temp = newValue.toFloat();
-            Serial.printf("New failsafe temperature: %.1f°C\n", temp);
-            updateFailsafeTemperature(temp);
+            Serial.printf("New failsafe temperature: %.1f°C\n", appConfig.failsafeTemperature);
+            updateFailsafeTemperature(appConfig.failsafeTemperature);
         }
-        
-        // Immediate synchronization with application config
-        syncConfigToApp();
     });
     
     // Configuration save callback
     webConfig.onConfigSave([]() {
         Serial.println("Configuration saved to EEPROM!");
         
-        // Synchronize with application configuration
-        syncConfigToApp();
-        
         // Apply new configuration
         Serial.println("Applying new configuration...");
         applyNewConfiguration();
@@ -154,7 +164,6 @@ void setup() {
     // Configuration load callback
     webConfig.onConfigLoad([]() {
         Serial.println("Configuration loaded from EEPROM");
-        syncConfigToApp();
     });
     
     // Custom validator for complex checks
@@ -174,8 +183,7 @@ void setup() {
             }
             
             // Check that failsafe is higher than target
-            float targetTemp = webConfig.getFloat("target_temp");
-            if (temp <= targetTemp) {
+            if (temp <= appConfig.targetTemperature) {
                 return "Failsafe temperature must be higher than target temperature";
             }
         }
@@ -191,16 +199,14 @@ void setup() {
         // PWM range validation
         if (key == "min_light") {
             int minLight = value.toInt();
-            int maxLight = webConfig.getInt("max_light");
-            if (minLight >= maxLight) {
+            if (minLight >= appConfig.maxPWM) {
                 return "Minimum light must be less than maximum light";
             }
         }
         
         if (key == "max_light") {
             int maxLight = value.toInt();
-            int minLight = webConfig.getInt("min_light");
-            if (maxLight <= minLight) {
+            if (maxLight <= appConfig.minPWM) {
                 return "Maximum light must be greater than minimum light";
             }
         }
@@ -211,9 +217,8 @@ void setup() {
     // ===== START SYSTEM =====
     webConfig.begin();
     
-    // Load and synchronize configuration
+    // Load configuration, bound variables follow
     webConfig.load();
-    syncConfigToApp();
     
     // Initialize application according to configuration
     initializeApplication();
@@ -281,25 +286,6 @@ void loop() {
 
 // ===== HELPER FUNCTIONS =====
 
-void syncConfigToApp() {
-    // Synchronize web configuration with application structure
-    appConfig.deviceName = webConfig.getValue("device_name");
-    appConfig.operationMode = webConfig.getInt("control_mode");
-    appConfig.targetTemperature = webConfig.getFloat("target_temp");
-    appConfig.failsafeTemperature = webConfig.getFloat("failsafe_temp");
-    appConfig.enableLogging = webConfig.getBool("enable_logging");
-    appConfig.mqttServer = webConfig.getValue("mqtt_server");
-    appConfig.mqttPort = webConfig.getInt("mqtt_port");
-    appConfig.mqttUsername = webConfig.getValue("mqtt_username");
-    appConfig.mqttPassword = webConfig.getValue("mqtt_password");
-    appConfig.minPWM = webConfig.getInt("min_light");
-    appConfig.maxPWM = webConfig.getInt("max_light");
-    appConfig.dayMode = webConfig.getInt("light_cycle");
-    appConfig.dayStart = webConfig.getInt("day_start_hour");
-    
-    Serial.println("Configuration synchronized with application");
-}
-
 void printCurrentConfig() {
     Serial.println("=== CURRENT CONFIGURATION ===");
     Serial.printf("Name: %s\n", appConfig.deviceName.c_str());
@@ -0,0 +1,105 @@
+/*
+ * ESP32WebConfig Allocation Check
+ *
+ * Verifies that the hot paths do not touch the heap: the typed getters,
+ * handle reads and an idle handle() pass must perform zero allocations. Anything else
+ * the library allocated is listed per entry point.
+ *
+ * Build flags:
+ *   ESP32:   -DWEBCONFIG_ALLOC_TRACKING=1, and CONFIG_HEAP_USE_HOOKS=y in sdkconfig
+ *   ESP8266: -DWEBCONFIG_ALLOC_TRACKING=1 -DWEBCONFIG_ALLOC_WRAP_MALLOC=1
+ *            -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ *
+ * Output, one machine-readable line per check:
+ *   ALLOC,<check>,<iterations>,<allocations>,<PASS|FAIL>
+ *   ALLOC_RESULT,<PASS|FAIL|SKIP>
+ *
+ * The same checks run without hardware as the alloc_test ctest of the host
+ * build (CMakeLists.txt), which fails the build gate instead of printing.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include <ESP32WebConfig.h>
+
+const int ITERATIONS = 1000;
+
+ESP32WebConfig config;
+ParamHandle<int> intervalHandle;
+ParamHandle<float> offsetHandle;
+bool allPassed = true;
+
+#if WEBCONFIG_ALLOC_TRACKING
+
+// Runs body() iterations times and fails if the loop task allocated
+template <typename Body>
+void expectNoAlloc(const char* check, Body body) {
+    uint32_t before = WebConfigAlloc::getTaskCount();
+    for (int i = 0; i < ITERATIONS; i++) {
+        body();
+    }
+    uint32_t allocations = WebConfigAlloc::getTaskCount() - before;
+    bool pass = allocations == 0;
+    allPassed &= pass;
+    Serial.printf("ALLOC,%s,%d,%lu,%s\n", check, ITERATIONS, (unsigned long)allocations, pass ? "PASS" : "FAIL");
+}
+
+void printEntryPoints() {
+    for (uint8_t id = 0; id < ALLOC_ID_COUNT; id++) {
+        WebConfigAlloc::Counter c = WebConfigAlloc::get(id);
+        if (c.count) {
+            Serial.printf("ALLOC_ENTRY,%s,%lu,%lu\n", WebConfigAlloc::getName(id),
+                          (unsigned long)c.count, (unsigned long)c.bytes);
+        }
+    }
+}
+
+#endif
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println();
+
+    config.setDeviceName("AllocCheck");
+    config.setAPConfig("AllocCheck-Setup", "12345678");
+    intervalHandle = config.addNumberParameter("interval", "Interval (s)", 60, 1, 3600);
+    offsetHandle = config.addFloatParameter("offset", "Offset", 0.5);
+    config.addCheckboxParameter("enabled", "Enabled", true);
+    config.addTextParameter("mqtt_topic", "MQTT topic", "sensors/outdoor/temperature");
+    config.begin();
+
+    #if WEBCONFIG_ALLOC_TRACKING
+    if (!WebConfigAlloc::isActive()) {
+        Serial.println("No allocator hook compiled in, see the build flags at the top");
+        Serial.println("ALLOC_RESULT,SKIP");
+        return;
+    }
+
+    // Let the AP and web server settle before measuring the idle loop
+    for (int i = 0; i < 100; i++) {
+        config.handle();
+        delay(10);
+    }
+    WebConfigAlloc::reset();
+
+    volatile long sink = 0;
+    expectNoAlloc("getInt", [&]() { sink += config.getInt("interval"); });
+    expectNoAlloc("getFloat", [&]() { sink += (long)config.getFloat("offset"); });
+    expectNoAlloc("getBool", [&]() { sink += config.getBool("enabled"); });
+    expectNoAlloc("get_handle", [&]() { sink += config.get(intervalHandle) + (long)config.get(offsetHandle); });
+    expectNoAlloc("set_handle_same", [&]() { config.set(intervalHandle, 60); });
+    expectNoAlloc("handle_idle", [&]() { config.handle(); });
+
+    printEntryPoints();
+    Serial.printf("ALLOC_RESULT,%s\n", allPassed ? "PASS" : "FAIL");
+    #else
+    Serial.println("Build with -DWEBCONFIG_ALLOC_TRACKING=1 to run the checks");
+    Serial.println("ALLOC_RESULT,SKIP");
+    #endif
+}
+
+void loop() {
+    config.handle();
+}
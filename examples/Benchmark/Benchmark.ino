@@ -0,0 +1,232 @@
+/*
+ * ESP32WebConfig Benchmark
+ *
+ * Measures how the library's hot paths scale with parameter count and
+ * value size: registration, compaction, lookup, set, save, load, export,
+ * import and page rendering, plus the cost of one /api/status poll at 10
+ * polls per second.
+ *
+ * Every result is printed as one machine-readable line:
+ *   BENCH,<op>,<params>,<value_len>,<iterations>,<ns_per_op>,<heap_delta>,<min_free_heap>,<ok>,<allocs_per_op>
+ * Capture the serial log and compare two runs with extras/Tools/bench_diff.py.
+ * Operations that build a JsonDocument add one line on the JSON pool:
+ *   BENCH_JSON,<op>,<params>,<value_len>,<allocs_per_op>,<heap_fallbacks>,<pool_peak>
+ *
+ * allocs_per_op is rounded up, so any allocation shows as at least 1. It
+ * needs -DWEBCONFIG_ALLOC_TRACKING=1 (see examples/AllocCheck for the hook
+ * flags) and is -1 without it; the host build's Benchmark target has it on.
+ *
+ * Notes:
+ * - save() commits to flash; its iteration count is kept low to limit wear
+ * - 500 parameters exceed the default 4 KB EEPROM area, save reports ok=0
+ * - ESP8266 may run out of heap at the largest sweep point
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include <ESP32WebConfig.h>
+#if WEBCONFIG_ENABLE_PAGES
+#include <WebPages.h>
+#endif
+
+// Sweep configuration
+const int PARAM_COUNTS[] = { 10, 50, 200, 500 };
+const int VALUE_LENGTHS[] = { 8, 64 };
+const int LOOKUP_ITERATIONS = 1000;
+const int SERIALIZE_ITERATIONS = 20;
+const int SAVE_ITERATIONS = 3;
+const int RENDER_ITERATIONS = 5;
+const int STATUS_POLLS = 50;
+const unsigned long STATUS_POLL_INTERVAL_MS = 100;
+
+uint32_t minFreeHeap = 0;
+
+// Heap allocations made by this task so far, or -1 when not counted
+long allocationCount() {
+    #if WEBCONFIG_ALLOC_TRACKING
+    if (WebConfigAlloc::isActive()) return (long)WebConfigAlloc::getTaskCount();
+    #endif
+    return -1;
+}
+
+void report(const char* op, int params, int valueLen, int iterations,
+            unsigned long elapsedMicros, long heapDelta, long allocations, bool ok) {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap < minFreeHeap) minFreeHeap = freeHeap;
+
+    unsigned long nsPerOp = iterations > 0 ? (unsigned long)((elapsedMicros * 1000ULL) / iterations) : 0;
+    long allocsPerOp = allocations < 0 || iterations <= 0 ? -1 : (allocations + iterations - 1) / iterations;
+    Serial.printf("BENCH,%s,%d,%d,%d,%lu,%ld,%lu,%d,%ld\n",
+                  op, params, valueLen, iterations, nsPerOp, heapDelta, (unsigned long)minFreeHeap, ok ? 1 : 0,
+                  allocsPerOp);
+}
+
+// Runs body() iterations times and reports time, heap change and allocations
+template <typename Body>
+void measure(const char* op, int params, int valueLen, int iterations, Body body) {
+    bool ok = true;
+    uint32_t heapBefore = ESP.getFreeHeap();
+    long allocsBefore = allocationCount();
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++) {
+        ok &= body();
+    }
+    unsigned long elapsed = micros() - start;
+    long allocations = allocsBefore < 0 ? -1 : allocationCount() - allocsBefore;
+    long heapDelta = (long)heapBefore - (long)ESP.getFreeHeap();
+    report(op, params, valueLen, iterations, elapsed, heapDelta, allocations, ok);
+}
+
+#if WEBCONFIG_ENABLE_JSON
+// Allocations the documents of the last measurement made, and how many of
+// them did not fit in the pool
+void reportJsonPool(const char* op, int params, int valueLen, int iterations, WebConfigJsonPool& pool) {
+    Serial.printf("BENCH_JSON,%s,%d,%d,%lu,%lu,%lu\n", op, params, valueLen,
+                  (unsigned long)(pool.getAllocations() / iterations),
+                  (unsigned long)pool.getHeapFallbacks(), (unsigned long)pool.getPeak());
+    pool.resetStats();
+}
+#endif
+
+void runSweepPoint(int paramCount, int valueLen) {
+    ESP32WebConfig* config = new ESP32WebConfig();
+
+    String value;
+    value.reserve(valueLen);
+    for (int i = 0; i < valueLen; i++) value += (char)('a' + (i % 26));
+
+    char key[16];
+    measure("add", paramCount, valueLen, 1, [&]() {
+        for (int i = 0; i < paramCount; i++) {
+            snprintf(key, sizeof(key), "p%03d", i);
+            config->addTextParameter(key, key, value);
+        }
+        return config->getParameterCount() == paramCount;
+    });
+    // What begin() does before the first lookup
+    measure("compact", paramCount, valueLen, 1, [&]() {
+        return config->compactParameters();
+    });
+
+    // Last registered key, the worst case before compaction
+    snprintf(key, sizeof(key), "p%03d", paramCount - 1);
+    String lastKey = key;
+
+    measure("getValue", paramCount, valueLen, LOOKUP_ITERATIONS, [&]() {
+        return config->getValue(lastKey).length() == (unsigned)valueLen;
+    });
+    measure("getInt", paramCount, valueLen, LOOKUP_ITERATIONS, [&]() {
+        config->getInt(lastKey);
+        return true;
+    });
+
+    String altValue = value;
+    altValue[0] = 'Z';
+    int n = 0;
+    measure("setValue", paramCount, valueLen, LOOKUP_ITERATIONS, [&]() {
+        return config->setValue(lastKey, (n++ & 1) ? value : altValue);
+    });
+
+    #if WEBCONFIG_ENABLE_JSON
+    WebConfigJsonPool& pool = config->getJsonPool();
+    pool.resetStats();
+    #endif
+
+    measure("save", paramCount, valueLen, SAVE_ITERATIONS, [&]() {
+        return config->save();
+    });
+    #if WEBCONFIG_ENABLE_JSON
+    reportJsonPool("save", paramCount, valueLen, SAVE_ITERATIONS, pool);
+    #endif
+    measure("load", paramCount, valueLen, SAVE_ITERATIONS, [&]() {
+        return config->load();
+    });
+
+    #if WEBCONFIG_ENABLE_JSON
+    reportJsonPool("load", paramCount, valueLen, SAVE_ITERATIONS, pool);
+    String exported;
+    measure("exportConfig", paramCount, valueLen, SERIALIZE_ITERATIONS, [&]() {
+        exported = config->exportConfig();
+        return exported.length() > 0;
+    });
+    reportJsonPool("exportConfig", paramCount, valueLen, SERIALIZE_ITERATIONS, pool);
+    measure("importConfig", paramCount, valueLen, SERIALIZE_ITERATIONS, [&]() {
+        return config->importConfig(exported);
+    });
+    reportJsonPool("importConfig", paramCount, valueLen, SERIALIZE_ITERATIONS, pool);
+    exported = String();
+    #endif
+
+    delete config;
+}
+
+void runRenderBenchmarks() {
+    #if WEBCONFIG_ENABLE_PAGES
+    measure("render_main", 0, 0, RENDER_ITERATIONS, []() {
+        return WebPages::getMainPage().length() > 0;
+    });
+    measure("render_config", 0, 0, RENDER_ITERATIONS, []() {
+        return WebPages::getConfigPage().length() > 0;
+    });
+    measure("render_network", 0, 0, RENDER_ITERATIONS, []() {
+        return WebPages::getNetworkPage().length() > 0;
+    });
+    measure("render_backup", 0, 0, RENDER_ITERATIONS, []() {
+        return WebPages::getBackupPage().length() > 0;
+    });
+    #endif
+}
+
+// Polls the status body like a browser tab at 10 polls per second; only
+// the getStatusJSON() calls are timed. The first call builds the cache.
+void runStatusBenchmark() {
+    ESP32WebConfig* config = new ESP32WebConfig();
+    measure("status_build", 0, 0, 1, [&]() {
+        return config->getStatusJSON().length() > 0;
+    });
+
+    bool ok = true;
+    uint32_t heapBefore = ESP.getFreeHeap();
+    long allocsBefore = allocationCount();
+    unsigned long elapsed = 0;
+    for (int i = 0; i < STATUS_POLLS; i++) {
+        unsigned long start = micros();
+        ok &= config->getStatusJSON().length() > 0;
+        elapsed += micros() - start;
+        delay(STATUS_POLL_INTERVAL_MS);
+    }
+    long allocations = allocsBefore < 0 ? -1 : allocationCount() - allocsBefore;
+    report("status_poll", 0, 0, STATUS_POLLS, elapsed, (long)heapBefore - (long)ESP.getFreeHeap(), allocations, ok);
+    delete config;
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) delay(10);
+    delay(1000);
+
+    // save()/load() need EEPROM without starting WiFi through begin()
+    EEPROM.begin(WEBCONFIG_EEPROM_SIZE);
+    minFreeHeap = ESP.getFreeHeap();
+
+    Serial.println("=== ESP32WebConfig Benchmark ===");
+    Serial.printf("BENCH_META,version,%s\n", ESP32WEBCONFIG_VERSION);
+    Serial.printf("BENCH_META,cpu_mhz,%lu\n", (unsigned long)ESP.getCpuFreqMHz());
+    Serial.printf("BENCH_META,free_heap,%lu\n", (unsigned long)ESP.getFreeHeap());
+    Serial.println("BENCH_HEADER,op,params,value_len,iterations,ns_per_op,heap_delta,min_free_heap,ok,allocs_per_op");
+
+    for (int paramCount : PARAM_COUNTS) {
+        for (int valueLen : VALUE_LENGTHS) {
+            runSweepPoint(paramCount, valueLen);
+        }
+    }
+    runRenderBenchmarks();
+    runStatusBenchmark();
+
+    Serial.println("BENCH_DONE");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,73 @@
+/*
+ * ESP32WebConfig Boot Profile
+ *
+ * Prints how long each phase of begin() took and how much heap it used,
+ * as a waterfall on the serial port:
+ *
+ *   phase          start_us    dur_us   heap  |
+ *   eeprom                12       104   -512  |#
+ *   load                 118      2210   -128  |###
+ *   ...
+ *
+ * The same numbers are in /api/status under "boot".
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include <ESP32WebConfig.h>
+
+// Width of the waterfall bars in characters
+const int BAR_WIDTH = 40;
+
+ESP32WebConfig config;
+
+void printWaterfall(const WebConfigBootProfile& profile) {
+    uint32_t total = profile.totalMicros ? profile.totalMicros : 1;
+
+    Serial.printf("%-12s %10s %9s %7s  |\n", "phase", "start_us", "dur_us", "heap");
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        const WebConfigBootProfile::Phase& phase = profile.phases[i];
+        const char* name = WebConfigBootProfile::getName((WebConfigBootPhase)i);
+        if (phase.micros == 0) {
+            Serial.printf("%-12s %10s %9s %7s  |(skipped)\n", name, "-", "-", "-");
+            continue;
+        }
+
+        int offset = (uint64_t)phase.startMicros * BAR_WIDTH / total;
+        int length = (uint64_t)phase.micros * BAR_WIDTH / total;
+        if (length == 0) length = 1;
+
+        Serial.printf("%-12s %10lu %9lu %7ld  |", name, (unsigned long)phase.startMicros,
+                      (unsigned long)phase.micros, (long)phase.heapDelta);
+        for (int c = 0; c < offset; c++) Serial.print(' ');
+        for (int c = 0; c < length; c++) Serial.print('#');
+        Serial.println();
+    }
+
+    Serial.printf("%-12s %10s %9lu %7ld\n", "begin()", "", (unsigned long)profile.totalMicros,
+                  (long)((int32_t)(profile.heapAfter - profile.heapBefore)));
+    Serial.printf("begin() entered %lu ms after power-on, serving at %lu ms\n",
+                  (unsigned long)profile.beginMillis, (unsigned long)profile.readyMillis());
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    config.setDeviceName("BootProfile");
+    config.setAPConfig("BootProfile-Setup", "12345678");
+    config.addTextParameter("mqtt_host", "MQTT host", "broker.local");
+    config.addNumberParameter("interval", "Interval (s)", 60, 1, 3600);
+    config.addCheckboxParameter("enabled", "Enabled", true);
+
+    config.begin();
+
+    // Serial output is deferred until after begin() so it does not skew the timing
+    delay(500);
+    Serial.println();
+    printWaterfall(config.getBootProfile());
+}
+
+void loop() {
+    config.handle();
+}
@@ -0,0 +1,124 @@
+/*
+ * ESP32WebConfig Footprint
+ *
+ * Prints the RAM a configuration object costs at runtime: sizeof of the
+ * parameter records and of the config class, static parameter storage,
+ * and free heap before and after begin().
+ *
+ * Every value is printed as one machine-readable line:
+ *   FOOTPRINT,<key>,<value>
+ * Capture the serial log and pass it to extras/Tools/footprint.py --serial-log.
+ *
+ * Build with -DFOOTPRINT_MINIMAL=1 to measure ZonioMinimalConfig instead
+ * of ESP32WebConfig; only one of them can own the AP and port 80.
+ * Build with -DFOOTPRINT_DESCRIPTORS=1 to register the ESP32WebConfig
+ * parameters from a const descriptor table instead of addTextParameter(),
+ * so params_heap_cost shows what flash-resident metadata saves.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef FOOTPRINT_MINIMAL
+#define FOOTPRINT_MINIMAL 0
+#endif
+
+#ifndef FOOTPRINT_DESCRIPTORS
+#define FOOTPRINT_DESCRIPTORS 0
+#endif
+
+// Parameters registered, comparable to a typical sensor node
+const int PARAM_COUNT = 8;
+
+#if FOOTPRINT_MINIMAL
+#include "ZonioMinimalConfig.h"
+#define PREFIX "zonio"
+#elif FOOTPRINT_DESCRIPTORS
+#include <ESP32WebConfig.h>
+#define PREFIX "descriptors"
+#else
+#include <ESP32WebConfig.h>
+#define PREFIX "webconfig"
+#endif
+
+#if !FOOTPRINT_MINIMAL && FOOTPRINT_DESCRIPTORS
+// Same parameters as the addTextParameter() loop below, kept in flash
+const ConfigParameterDescriptor PARAMS[PARAM_COUNT] PROGMEM = {
+    { "param0", "param0", PARAM_TEXT, "value" },
+    { "param1", "param1", PARAM_TEXT, "value" },
+    { "param2", "param2", PARAM_TEXT, "value" },
+    { "param3", "param3", PARAM_TEXT, "value" },
+    { "param4", "param4", PARAM_TEXT, "value" },
+    { "param5", "param5", PARAM_TEXT, "value" },
+    { "param6", "param6", PARAM_TEXT, "value" },
+    { "param7", "param7", PARAM_TEXT, "value" },
+};
+#endif
+
+void report(const char* key, unsigned long value) {
+    Serial.printf("FOOTPRINT,%s_%s,%lu\n", key, PREFIX, value);
+}
+
+uint32_t largestFreeBlock() {
+    #ifdef ESP8266
+    return ESP.getMaxFreeBlockSize();
+    #else
+    return ESP.getMaxAllocHeap();
+    #endif
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println();
+    Serial.println("FOOTPRINT_META," PREFIX);
+
+    uint32_t heapAtStart = ESP.getFreeHeap();
+
+    #if FOOTPRINT_MINIMAL
+    report("sizeof_param", ZonioMinimalConfig::PARAM_BYTES);
+    report("sizeof_config", sizeof(ZonioMinimalConfig));
+    report("param_table_bytes", ZonioMinimalConfig::PARAM_BYTES * ZonioMinimalConfig::MAX_PARAMS);
+
+    static ZonioMinimalConfig config;
+    config.setDeviceName("Footprint");
+    uint32_t heapBeforeParams = ESP.getFreeHeap();
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "param%d", i);
+        config.addParameter(key, key, "value");
+    }
+    #else
+    report("sizeof_param", sizeof(ConfigParameter));
+    report("sizeof_config", sizeof(ESP32WebConfig));
+
+    static ESP32WebConfig config;
+    config.setDeviceName("Footprint");
+    uint32_t heapBeforeParams = ESP.getFreeHeap();
+    #if FOOTPRINT_DESCRIPTORS
+    config.addParameters(PARAMS, PARAM_COUNT);
+    #else
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        String key = "param" + String(i);
+        config.addTextParameter(key, key, "value");
+    }
+    #endif
+    #endif
+
+    // Parameter storage is static in ZonioMinimalConfig and heap in ESP32WebConfig
+    report("params_heap_cost", heapBeforeParams - ESP.getFreeHeap());
+
+    uint32_t heapBeforeBegin = ESP.getFreeHeap();
+    config.begin();
+    uint32_t heapAfterBegin = ESP.getFreeHeap();
+
+    report("heap_at_start", heapAtStart);
+    report("begin_heap_cost", heapBeforeBegin - heapAfterBegin);
+    report("heap_after_begin", heapAfterBegin);
+    report("heap_largest_block_after_begin", largestFreeBlock());
+    Serial.println("FOOTPRINT_DONE");
+}
+
+void loop() {
+    delay(1000);
+}
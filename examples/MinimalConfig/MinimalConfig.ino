@@ -20,8 +20,9 @@
 
 #include "ZonioMinimalConfig.h"
 
-// Create minimal config instance
-ZonioMinimalConfig zonioConfig;
+// Create minimal config instance: 9 parameters (ZonioMinimalConfig holds 8),
+// 64-byte values, no select options, 3 KB configuration page
+ZonioMinimalConfigT<9, 64, 1, 3072> zonioConfig;
 
 // Configuration variables (loaded from web interface)
 char wifiSSID[64];
@@ -0,0 +1,53 @@
+/*
+ * ESP32WebConfig Schema Example
+ *
+ * Declares the parameters once at compile time with WEBCONFIG_SCHEMA.
+ * The application reads them through typed accessors (sensor.interval())
+ * that are plain member loads; a misspelt name does not compile. The same
+ * parameters appear in the web interface and are saved to EEPROM, and
+ * values changed there show up in the accessors.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include <ESP32WebConfig.h>
+#include <WebConfigSchema.h>
+
+//     type    name       label               default          min   max
+#define SENSOR_PARAMS(P) \
+    P(int,    interval,  "Interval (s)",     60,              1,    3600) \
+    P(float,  offset,    "Offset (°C)",      0.0,             -10,  10)   \
+    P(bool,   enabled,   "Enabled",          true,            0,    0)    \
+    P(String, topic,     "MQTT topic",       "sensors/room",  0,    0)
+WEBCONFIG_SCHEMA(SensorConfig, SENSOR_PARAMS);
+
+ESP32WebConfig config;
+SensorConfig sensor;
+unsigned long lastReading = 0;
+
+void setup() {
+    Serial.begin(115200);
+
+    config.setDeviceName("Schema Sensor");
+    config.setAPConfig("Schema-Setup", "12345678");
+    sensor.registerWith(config);
+    config.begin();
+
+    // String keys, e.g. from a custom handler, go through the perfect hash
+    Serial.printf("topic = %s\n", sensor.getValue("topic").c_str());
+    if (!sensor.interval(0)) {
+        Serial.println("interval 0 rejected, outside 1..3600");
+    }
+}
+
+void loop() {
+    config.handle();
+
+    if (!sensor.enabled()) return;
+    if (millis() - lastReading < (unsigned long)sensor.interval() * 1000UL) return;
+    lastReading = millis();
+
+    float temperature = 21.5 + sensor.offset();
+    Serial.printf("%s: %.2f\n", sensor.topic().c_str(), temperature);
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+ESP32WebConfig benchmark comparison
+
+Reads two serial logs captured from examples/Benchmark and prints the
+change of every BENCH result. Exits with status 1 when any ns_per_op,
+heap_delta or allocs_per_op regressed by more than --threshold percent;
+an operation that starts allocating always counts. Logs from before the
+allocs_per_op column, or built without allocation tracking (-1), are
+compared on time and heap only.
+
+Examples:
+    python3 bench_diff.py v1.0.0.log current.log
+    python3 bench_diff.py baseline.log current.log --threshold 10 --csv diff.csv
+
+Author: ZONIO Project Team
+License: MIT
+"""
+
+import argparse
+import csv
+import sys
+
+FIELDS = ["op", "params", "value_len", "iterations", "ns_per_op", "heap_delta", "min_free_heap", "ok",
+          "allocs_per_op"]
+METRICS = ["ns_per_op", "heap_delta", "allocs_per_op"]
+
+
+def load(path):
+    """Return {(op, params, value_len): row} from a benchmark log."""
+    results = {}
+    header = FIELDS
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("BENCH_HEADER,"):
+                header = line.split(",")[1:]
+            elif line.startswith("BENCH,"):
+                values = line.split(",")[1:]
+                names = header if len(values) == len(header) else FIELDS[:len(values)]
+                if len(values) != len(names):
+                    continue
+                row = dict(zip(names, values))
+                for k in names:
+                    if k != "op":
+                        row[k] = int(row[k])
+                results[(row["op"], row["params"], row["value_len"])] = row
+    return results
+
+
+def allocs(row):
+    """allocs_per_op, or None when the log did not count allocations."""
+    value = row.get("allocs_per_op", -1)
+    return value if value >= 0 else None
+
+
+def compared(b, c, metric):
+    return metric != "allocs_per_op" or (allocs(b) is not None and allocs(c) is not None)
+
+
+def change(old, new):
+    if old == 0:
+        return 0.0 if new == 0 else float("inf")
+    return (new - old) * 100.0 / abs(old)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two ESP32WebConfig benchmark logs")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=15.0, help="Allowed regression in percent")
+    parser.add_argument("--csv", help="Write the comparison to this file")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    if not base or not cur:
+        print("No BENCH lines found", file=sys.stderr)
+        return 2
+
+    rows = []
+    regressions = 0
+    print(f"{'op':<16} {'params':>6} {'len':>4} {'ns/op old':>12} {'ns/op new':>12} {'change':>8} {'heap old':>9} {'heap new':>9}"
+          f" {'alloc old':>9} {'alloc new':>9}")
+    for key in sorted(set(base) | set(cur), key=lambda k: (k[0], k[1], k[2])):
+        b = base.get(key)
+        c = cur.get(key)
+        if not b or not c:
+            print(f"{key[0]:<16} {key[1]:>6} {key[2]:>4} {'missing in ' + ('baseline' if not b else 'current'):>30}")
+            continue
+
+        ns_change = change(b["ns_per_op"], c["ns_per_op"])
+        heap_change = change(b["heap_delta"], c["heap_delta"])
+        regressed = c["ok"] < b["ok"] or any(
+            compared(b, c, m) and change(b[m], c[m]) > args.threshold and c[m] > b[m] for m in METRICS)
+        regressions += regressed
+
+        flag = "  REGRESSION" if regressed else ""
+        print(f"{key[0]:<16} {key[1]:>6} {key[2]:>4} {b['ns_per_op']:>12} {c['ns_per_op']:>12} "
+              f"{ns_change:>7.1f}% {b['heap_delta']:>9} {c['heap_delta']:>9}"
+              f" {str(allocs(b) if allocs(b) is not None else '-'):>9} {str(allocs(c) if allocs(c) is not None else '-'):>9}{flag}")
+        rows.append({"op": key[0], "params": key[1], "value_len": key[2],
+                     "ns_old": b["ns_per_op"], "ns_new": c["ns_per_op"], "ns_change_pct": round(ns_change, 2),
+                     "heap_old": b["heap_delta"], "heap_new": c["heap_delta"],
+                     "heap_change_pct": round(heap_change, 2),
+                     "allocs_old": allocs(b), "allocs_new": allocs(c), "regressed": int(regressed)})
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()) if rows else ["op"])
+            writer.writeheader()
+            writer.writerows(rows)
+
+    print(f"\n{regressions} regression(s) above {args.threshold}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
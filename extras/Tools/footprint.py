@@ -0,0 +1,341 @@
+#!/usr/bin/env python3
+"""
+ESP32WebConfig flash and RAM footprint report
+
+Compiles every example for ESP32 and ESP8266 with arduino-cli and reads
+the linker map to report .text/.rodata/.data/.bss per translation unit,
+grouped into sketch, this library, other libraries and the core/SDK.
+Only what survives --gc-sections is counted, so the numbers are what the
+firmware actually carries.
+
+Runtime figures (sizeof of the parameter tables, heap after begin()) come
+from examples/Footprint; pass its serial output with --serial-log. The
+sketch measures ESP32WebConfig by default and ZonioMinimalConfig when
+built with --define FOOTPRINT_MINIMAL=1; both logs can be concatenated.
+
+--switches builds one example (Footprint unless --example is given) once
+with defaults and once per WEBCONFIG_ENABLE_* switch set to 0, plus once
+with all of them off, and prints the flash and RAM each switch saves.
+
+Budgets are a JSON file keyed by board and example:
+    {"esp8266:esp8266:d1_mini": {"Footprint": {"library_flash": 60000, "heap_after_begin_webconfig": 20000}}}
+Metrics starting with "heap_" are lower bounds, all others upper bounds.
+
+Examples:
+    python3 footprint.py
+    python3 footprint.py --fqbn esp8266:esp8266:d1_mini --example MinimalConfig --per-tu
+    python3 footprint.py --budget budget.json --json footprint.json
+    python3 footprint.py --serial-log footprint_esp32.log --budget budget.json
+    python3 footprint.py --write-budget budget.json --margin 5
+    python3 footprint.py --switches --fqbn esp8266:esp8266:d1_mini
+
+Author: ZONIO Project Team
+License: MIT
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+REPO = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+LIBRARY = "ESP32WebConfig"
+DEFAULT_FQBNS = ["esp32:esp32:esp32", "esp8266:esp8266:d1_mini"]
+CATEGORIES = ["text", "rodata", "data", "bss"]
+SWITCHES = ["PAGES", "CAPTIVE_DNS", "MDNS", "JSON", "AUTH"]
+SWITCH_METRICS = ["image_flash", "image_ram", "library_flash", "library_ram"]
+
+OUTPUT_SECTION = re.compile(r"^(\.[\w.]+)(?:\s+0x[0-9a-f]+\s+0x[0-9a-f]+)?\s*$")
+INPUT_SECTION = re.compile(r"^ (\.\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*))?$")
+CONTINUATION = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$")
+
+
+def classify(output_section):
+    """Map an ESP32/ESP8266 output section to text/rodata/data/bss."""
+    name = output_section.lower()
+    if "bss" in name or "noinit" in name:
+        return "bss"
+    if "rodata" in name or "appdesc" in name:
+        return "rodata"
+    if "data" in name:
+        return "data"
+    if "text" in name or "vectors" in name or "literal" in name:
+        return "text"
+    return None
+
+
+def object_owner(path):
+    """Return (group, translation unit) for an object file path from the map."""
+    path = path.strip().replace("\\", "/")
+    archive = re.match(r"(.*?)\((.*)\)$", path)
+    member = archive.group(2) if archive else os.path.basename(path)
+    container = archive.group(1) if archive else path
+    tu = re.sub(r"\.(o|obj)$", "", member)
+
+    container = "/" + container
+    m = re.search(r"/libraries/([^/]+)/", container)
+    if m:
+        # arduino-cli names the folder after the checkout, which need not match the library name
+        return (LIBRARY if m.group(1) == os.path.basename(REPO) else m.group(1)), tu
+    if "/sketch/" in container:
+        return "sketch", tu
+    if "/core/" in container or container.endswith("core.a"):
+        return "core", tu
+    return "sdk", tu
+
+
+def parse_map(path):
+    """Return {(group, tu): {category: bytes}} from a GNU ld map file."""
+    sizes = {}
+    category = None
+    pending = False
+    in_map = False
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if not in_map:
+                in_map = line.startswith("Linker script and memory map")
+                continue
+            if not line.strip():
+                continue
+
+            if not line.startswith(" "):
+                m = OUTPUT_SECTION.match(line)
+                category = classify(m.group(1)) if m else None
+                pending = False
+                continue
+            if category is None:
+                continue
+
+            m = INPUT_SECTION.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending = True      # Long section name, address on the next line
+                    continue
+                address, size, owner = m.group(2), m.group(3), m.group(4)
+            elif pending:
+                m = CONTINUATION.match(line)
+                pending = False
+                if not m:
+                    continue
+                address, size, owner = m.groups()
+            else:
+                continue
+
+            size = int(size, 16)
+            if not size or int(address, 16) == 0:
+                continue
+            key = object_owner(owner)
+            entry = sizes.setdefault(key, dict.fromkeys(CATEGORIES, 0))
+            entry[category] += size
+    return sizes
+
+
+def summarize(sizes, fqbn):
+    groups = {}
+    for (group, _), entry in sizes.items():
+        g = groups.setdefault(group, dict.fromkeys(CATEGORIES, 0))
+        for c in CATEGORIES:
+            g[c] += entry[c]
+    image = dict.fromkeys(CATEGORIES, 0)
+    for g in groups.values():
+        for c in CATEGORIES:
+            image[c] += g[c]
+
+    # ESP8266 copies .rodata to DRAM at boot; ESP32 maps it from flash
+    rodata_in_ram = fqbn.startswith("esp8266:")
+
+    def totals(e):
+        return {"flash": e["text"] + e["rodata"] + e["data"],
+                "ram": e["data"] + e["bss"] + (e["rodata"] if rodata_in_ram else 0)}
+
+    metrics = {}
+    for c in CATEGORIES:
+        metrics["image_" + c] = image[c]
+    for k, v in totals(image).items():
+        metrics["image_" + k] = v
+    lib = groups.get(LIBRARY, dict.fromkeys(CATEGORIES, 0))
+    for c in CATEGORIES:
+        metrics["library_" + c] = lib[c]
+    for k, v in totals(lib).items():
+        metrics["library_" + k] = v
+    return groups, metrics
+
+
+def find_map(build_dir):
+    for name in os.listdir(build_dir):
+        if name.endswith(".map"):
+            return os.path.join(build_dir, name)
+    return None
+
+
+def compile_example(cli, fqbn, example, build_dir, defines):
+    cmd = [cli, "compile", "--fqbn", fqbn, "--library", REPO, "--build-path", build_dir,
+           os.path.join(REPO, "examples", example)]
+    if defines:
+        cmd[2:2] = ["--build-property", "compiler.cpp.extra_flags=" + " ".join("-D" + d for d in defines)]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout[-2000:] + result.stderr[-2000:])
+        return None
+    return find_map(build_dir)
+
+
+def read_serial_log(path):
+    """FOOTPRINT,<key>,<value> lines from examples/Footprint."""
+    values = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            parts = line.strip().split(",")
+            if len(parts) == 3 and parts[0] == "FOOTPRINT":
+                try:
+                    values[parts[1]] = int(parts[2])
+                except ValueError:
+                    pass
+    return values
+
+
+def check_budget(budget, fqbn, example, metrics):
+    problems = []
+    for key, limit in budget.get(fqbn, {}).get(example, {}).items():
+        if key not in metrics:
+            continue
+        value = metrics[key]
+        if key.startswith("heap_") and value < limit:
+            problems.append(f"{fqbn} {example}: {key} {value} below budget {limit}")
+        elif not key.startswith("heap_") and value > limit:
+            problems.append(f"{fqbn} {example}: {key} {value} over budget {limit}")
+    return problems
+
+
+def print_report(fqbn, example, groups, metrics, sizes, per_tu):
+    print(f"\n=== {example} @ {fqbn} ===")
+    print(f"{'group':<24} {'text':>9} {'rodata':>9} {'data':>9} {'bss':>9}")
+    for name, g in sorted(groups.items(), key=lambda kv: -sum(kv[1].values())):
+        print(f"{name:<24} {g['text']:>9} {g['rodata']:>9} {g['data']:>9} {g['bss']:>9}")
+    print(f"{'image':<24} {metrics['image_text']:>9} {metrics['image_rodata']:>9} "
+          f"{metrics['image_data']:>9} {metrics['image_bss']:>9}   flash {metrics['image_flash']}  ram {metrics['image_ram']}")
+
+    if per_tu:
+        print(f"\n{'translation unit':<36} {'text':>9} {'rodata':>9} {'data':>9} {'bss':>9}")
+        for (group, tu), e in sorted(sizes.items(), key=lambda kv: -sum(kv[1].values())):
+            if group in (LIBRARY, "sketch") or per_tu == "all":
+                print(f"{group + '/' + tu:<36} {e['text']:>9} {e['rodata']:>9} {e['data']:>9} {e['bss']:>9}")
+
+    runtime = {k: v for k, v in metrics.items() if not k.startswith(("image_", "library_"))}
+    for k, v in sorted(runtime.items()):
+        print(f"{k:<36} {v:>9}")
+
+
+def measure_switches(cli, fqbn, example, defines):
+    """Return {variant: metrics} for the default build and each switch turned off."""
+    variants = [("default", [])] + [(s, ["WEBCONFIG_ENABLE_%s=0" % s]) for s in SWITCHES]
+    variants.append(("all_off", ["WEBCONFIG_ENABLE_%s=0" % s for s in SWITCHES]))
+    out = {}
+    for name, extra in variants:
+        build_dir = tempfile.mkdtemp(prefix=f"footprint-{example}-{name}-")
+        map_path = compile_example(cli, fqbn, example, build_dir, defines + extra)
+        if not map_path:
+            print(f"{example} @ {fqbn} [{name}]: compile failed or no linker map", file=sys.stderr)
+            continue
+        _, out[name] = summarize(parse_map(map_path), fqbn)
+    return out
+
+
+def print_switches(fqbn, example, variants):
+    print(f"\n=== {example} @ {fqbn}: bytes saved per switch ===")
+    print(f"{'switch off':<16} " + " ".join(f"{m:>14}" for m in SWITCH_METRICS))
+    base = variants.get("default")
+    if not base:
+        print("default build failed, nothing to compare")
+        return
+    print(f"{'(default)':<16} " + " ".join(f"{base[m]:>14}" for m in SWITCH_METRICS))
+    for name in SWITCHES + ["all_off"]:
+        if name in variants:
+            print(f"{name:<16} " + " ".join(f"{base[m] - variants[name][m]:>14}" for m in SWITCH_METRICS))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash/RAM footprint of the ESP32WebConfig examples")
+    parser.add_argument("--fqbn", action="append", help=f"Board, repeatable (default {', '.join(DEFAULT_FQBNS)})")
+    parser.add_argument("--example", action="append", help="Example name, repeatable (default all)")
+    parser.add_argument("--arduino-cli", default="arduino-cli")
+    parser.add_argument("--map", help="Analyze an existing linker map instead of compiling")
+    parser.add_argument("--define", action="append", default=[], help="Extra -D for the compile, repeatable")
+    parser.add_argument("--per-tu", nargs="?", const="library", choices=["library", "all"],
+                        help="List translation units of the sketch and library (or all)")
+    parser.add_argument("--serial-log", help="Serial output of examples/Footprint to merge in")
+    parser.add_argument("--budget", help="Budget JSON; exit 1 when exceeded")
+    parser.add_argument("--write-budget", help="Write the current numbers as a budget file")
+    parser.add_argument("--margin", type=float, default=5.0, help="Headroom in percent for --write-budget")
+    parser.add_argument("--json", help="Write all numbers to this file")
+    parser.add_argument("--switches", action="store_true",
+                        help="Measure what each WEBCONFIG_ENABLE_* switch saves")
+    args = parser.parse_args()
+
+    if args.switches:
+        results = {}
+        for fqbn in args.fqbn or DEFAULT_FQBNS:
+            for example in args.example or ["Footprint"]:
+                variants = measure_switches(args.arduino_cli, fqbn, example, args.define)
+                results.setdefault(fqbn, {})[example] = variants
+                print_switches(fqbn, example, variants)
+        if args.json:
+            with open(args.json, "w") as f:
+                json.dump(results, f, indent=2)
+        return 0 if all(v for e in results.values() for v in e.values()) else 1
+
+    fqbns = args.fqbn or DEFAULT_FQBNS
+    examples = args.example or sorted(d for d in os.listdir(os.path.join(REPO, "examples"))
+                                      if os.path.isdir(os.path.join(REPO, "examples", d)))
+    runtime = read_serial_log(args.serial_log) if args.serial_log else {}
+    budget = {}
+    if args.budget:
+        with open(args.budget) as f:
+            budget = json.load(f)
+
+    results = {}
+    problems = []
+    builds = [(fqbns[0], examples[0], args.map)] if args.map else [(b, e, None) for b in fqbns for e in examples]
+    for fqbn, example, map_path in builds:
+        if not map_path:
+            build_dir = tempfile.mkdtemp(prefix=f"footprint-{example}-")
+            map_path = compile_example(args.arduino_cli, fqbn, example, build_dir, args.define)
+            if not map_path:
+                print(f"{example} @ {fqbn}: compile failed or no linker map", file=sys.stderr)
+                problems.append(f"{fqbn} {example}: build failed")
+                continue
+
+        sizes = parse_map(map_path)
+        groups, metrics = summarize(sizes, fqbn)
+        if example == "Footprint":
+            metrics.update(runtime)
+        results.setdefault(fqbn, {})[example] = metrics
+        print_report(fqbn, example, groups, metrics, sizes, args.per_tu)
+        problems += check_budget(budget, fqbn, example, metrics)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+    if args.write_budget:
+        out = {}
+        for fqbn, per_example in results.items():
+            for example, metrics in per_example.items():
+                out.setdefault(fqbn, {})[example] = {
+                    k: int(v * (1 - args.margin / 100) if k.startswith("heap_") else v * (1 + args.margin / 100))
+                    for k, v in metrics.items() if k in ("image_flash", "image_ram", "library_flash", "library_ram")
+                    or k.startswith("heap_")}
+        with open(args.write_budget, "w") as f:
+            json.dump(out, f, indent=2)
+
+    for p in problems:
+        print("BUDGET: " + p)
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
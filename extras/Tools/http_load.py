@@ -0,0 +1,486 @@
+#!/usr/bin/env python3
+"""
+ESP32WebConfig HTTP load and soak generator
+
+Runs N concurrent clients against a running ESP32WebConfig server and
+reports requests/sec, latency percentiles and heap behaviour per
+concurrency level. The default request mix replays what browsers do:
+page loads, /api/status polls, /save posts and exports.
+
+Heap is sampled from /api/status while the load runs and once more after
+it settles; a server that keeps less free heap after the load than before
+it is reported as leaking. The largest free block is sampled alongside, so
+a long --soak also shows whether the heap fragments.
+
+--host-build runs without hardware: it builds the host program of an
+example (CMakeLists.txt in the repository root) into the given directory,
+starts it on loopback with its EEPROM in a temporary directory, runs the
+load and stops it again. Any failed request fails the run in this mode.
+
+Examples:
+    python3 http_load.py 192.168.4.1 --clients 1,4,8 --duration 20
+    python3 http_load.py 192.168.4.1 --mix page=1,status=10 --no-keep-alive
+    python3 http_load.py 192.168.4.1 --soak 3600 --clients 4 --json soak.json
+    python3 http_load.py 192.168.4.1 --soak 86400 --clients 2 --sample-interval 60 --json day.json
+    python3 http_load.py 192.168.4.1 --json current.json --baseline v1.json --threshold 15
+    python3 http_load.py --host-build build --clients 1,4 --duration 5
+
+Author: ZONIO Project Team
+License: MIT
+"""
+
+import argparse
+import base64
+import http.client
+import json
+import os
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+import urllib.parse
+
+# Named requests for --mix; "save" posts the device's current values back,
+# so it exercises form parsing without rewriting flash
+REQUESTS = {
+    "page":   ("GET", "/"),
+    "config": ("GET", "/config"),
+    "status": ("GET", "/api/status"),
+    "save":   ("POST", "/save"),
+    "export": ("GET", "/export"),
+}
+DEFAULT_MIX = "page=2,status=6,save=1,export=1"
+
+# Device port 80 is moved by WEBCONFIG_HOST_PORT_OFFSET in the host build
+HOST_HTTP_PORT = 80
+REPO_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+
+def percentile(sorted_values, pct):
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, int(round(pct / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def parse_mix(text):
+    schedule = []
+    for part in text.split(","):
+        name, _, weight = part.partition("=")
+        if name not in REQUESTS:
+            raise ValueError(f"unknown request '{name}', choose from {', '.join(REQUESTS)}")
+        schedule += [name] * int(weight or 1)
+    return schedule
+
+
+class Device:
+    """Single-connection helper for setup requests and heap sampling."""
+
+    def __init__(self, args, headers):
+        self.args = args
+        self.headers = headers
+
+    def get(self, path):
+        conn = http.client.HTTPConnection(self.args.host, self.args.port, timeout=self.args.timeout)
+        try:
+            conn.request("GET", path, headers=self.headers)
+            response = conn.getresponse()
+            body = response.read()
+            return response.status, body
+        finally:
+            conn.close()
+
+    def heap(self):
+        """(free heap, largest free block); block is None on older firmware."""
+        try:
+            status, body = self.get("/api/status")
+            if status == 200:
+                values = json.loads(body)
+                block = values.get("largest_free_block")
+                return int(values["free_heap"]), int(block) if block is not None else None
+        except (OSError, http.client.HTTPException, ValueError, KeyError):
+            pass
+        return None
+
+    def free_heap(self):
+        heap = self.heap()
+        return heap[0] if heap else None
+
+    def available(self, name):
+        """False when the firmware lacks the route, e.g. built without JSON.
+
+        Unknown URLs answer 404, or a redirect to the captive portal.
+        """
+        method, path = REQUESTS.get(name, ("GET", name))
+        status, _ = self.get("/api/config" if method == "POST" else path)
+        return status != 404 and not 300 <= status < 400
+
+    def save_body(self):
+        status, body = self.get("/api/config")
+        if status != 200:
+            raise OSError(f"/api/config returned {status}")
+        values = json.loads(body)
+        return urllib.parse.urlencode({k: str(v) for k, v in values.items()})
+
+
+class HostServer:
+    """Host build of an example, running on loopback for the load."""
+
+    def __init__(self, build_dir, sketch, offset):
+        self.build_dir = os.path.abspath(build_dir)
+        self.sketch = sketch
+        self.offset = offset
+        self.process = None
+        self.workdir = None
+
+    def build(self):
+        if not os.path.exists(os.path.join(self.build_dir, "CMakeCache.txt")):
+            subprocess.run(["cmake", "-S", REPO_ROOT, "-B", self.build_dir], check=True)
+        subprocess.run(["cmake", "--build", self.build_dir, "--target", self.sketch], check=True)
+
+    def start(self, timeout=10.0):
+        self.workdir = tempfile.TemporaryDirectory()
+        env = dict(os.environ,
+                   WEBCONFIG_HOST_PORT_OFFSET=str(self.offset),
+                   WEBCONFIG_HOST_EEPROM=os.path.join(self.workdir.name, "eeprom.bin"))
+        self.process = subprocess.Popen([os.path.join(self.build_dir, self.sketch)], env=env,
+                                        cwd=self.workdir.name, stdout=subprocess.DEVNULL)
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            if self.process.poll() is not None:
+                raise OSError(f"{self.sketch} exited with {self.process.returncode}")
+            try:
+                socket.create_connection(("127.0.0.1", self.port), timeout=0.5).close()
+                return
+            except OSError:
+                time.sleep(0.1)
+        self.stop()
+        raise OSError(f"{self.sketch} did not listen on port {self.port}")
+
+    def stop(self):
+        if self.process and self.process.poll() is None:
+            self.process.send_signal(signal.SIGTERM)
+            try:
+                self.process.wait(timeout=5)
+            except subprocess.TimeoutExpired:
+                self.process.kill()
+                self.process.wait()
+        if self.workdir:
+            self.workdir.cleanup()
+            self.workdir = None
+
+    @property
+    def port(self):
+        return HOST_HTTP_PORT + self.offset
+
+
+class Client(threading.Thread):
+    """One simulated browser issuing requests back to back."""
+
+    def __init__(self, args, schedule, offset, deadline, headers, save_body):
+        super().__init__(daemon=True)
+        self.args = args
+        self.schedule = schedule
+        self.offset = offset
+        self.deadline = deadline
+        self.headers = headers
+        self.save_body = save_body
+        self.latencies = {}
+        self.errors = 0
+        self.bytes = 0
+
+    def connect(self):
+        return http.client.HTTPConnection(self.args.host, self.args.port, timeout=self.args.timeout)
+
+    def run(self):
+        conn = self.connect()
+        i = self.offset
+        while time.monotonic() < self.deadline:
+            name = self.schedule[i % len(self.schedule)]
+            i += 1
+            method, path = REQUESTS.get(name, ("GET", name))
+            headers = dict(self.headers)
+            body = None
+            if method == "POST":
+                body = self.save_body
+                headers["Content-Type"] = "application/x-www-form-urlencoded"
+            if not self.args.keep_alive:
+                headers["Connection"] = "close"
+            start = time.perf_counter()
+            try:
+                conn.request(method, path, body=body, headers=headers)
+                response = conn.getresponse()
+                data = response.read()
+                elapsed = time.perf_counter() - start
+                if response.status >= 400:
+                    self.errors += 1
+                else:
+                    self.latencies.setdefault(name, []).append(elapsed)
+                    self.bytes += len(data)
+                if not self.args.keep_alive or response.will_close:
+                    conn.close()
+                    conn = self.connect()
+            except (OSError, http.client.HTTPException):
+                self.errors += 1
+                conn.close()
+                conn = self.connect()
+        conn.close()
+
+
+class HeapSampler(threading.Thread):
+    """Polls free heap while the load runs."""
+
+    def __init__(self, device, interval, deadline, progress=None):
+        super().__init__(daemon=True)
+        self.device = device
+        self.interval = interval
+        self.deadline = deadline
+        self.progress = progress
+        self.samples = []
+
+    def run(self):
+        start = time.monotonic()
+        while time.monotonic() < self.deadline:
+            heap = self.device.heap()
+            if heap is not None:
+                self.samples.append((round(time.monotonic() - start, 1),) + heap)
+                if self.progress:
+                    self.progress(self.samples[-1])
+            time.sleep(self.interval)
+
+
+def heap_slope(samples, column=1):
+    """Least-squares change of a sampled column in bytes per hour."""
+    points = [(s[0], s[column]) for s in samples if s[column] is not None]
+    if len(points) < 3:
+        return 0.0
+    n = len(points)
+    mean_t = sum(t for t, _ in points) / n
+    mean_h = sum(h for _, h in points) / n
+    var = sum((t - mean_t) ** 2 for t, _ in points)
+    if var == 0:
+        return 0.0
+    return sum((t - mean_t) * (h - mean_h) for t, h in points) / var * 3600
+
+
+def settled_heap(device, settle):
+    """Highest free heap seen over a few polls after the load stopped."""
+    time.sleep(settle)
+    values = [h for h in (device.free_heap() for _ in range(3)) if h is not None]
+    return max(values) if values else None
+
+
+def run_level(args, clients, schedule, headers, device, save_body, progress=None):
+    heap_before = settled_heap(device, 0) if args.heap else None
+
+    deadline = time.monotonic() + args.duration
+    workers = [Client(args, schedule, i * 7, deadline, headers, save_body) for i in range(clients)]
+    sampler = HeapSampler(device, args.sample_interval, deadline, progress) if args.heap else None
+    start = time.monotonic()
+    for w in workers:
+        w.start()
+    if sampler:
+        sampler.start()
+    for w in workers:
+        w.join()
+    wall = time.monotonic() - start
+
+    heap_after = settled_heap(device, args.settle) if args.heap else None
+
+    per_op = {}
+    for name in sorted({n for w in workers for n in w.latencies}):
+        values = sorted(l for w in workers for l in w.latencies.get(name, []))
+        per_op[name] = {"requests": len(values),
+                        "p50_ms": round(percentile(values, 50) * 1000, 2),
+                        "p99_ms": round(percentile(values, 99) * 1000, 2)}
+
+    latencies = sorted(l for w in workers for v in w.latencies.values() for l in v)
+    errors = sum(w.errors for w in workers)
+    samples = sampler.samples if sampler else []
+    result = {
+        "clients": clients,
+        "requests": len(latencies),
+        "errors": errors,
+        "bytes": sum(w.bytes for w in workers),
+        "duration_s": round(wall, 3),
+        "rps": round(len(latencies) / wall, 2) if wall > 0 else 0.0,
+        "p50_ms": round(percentile(latencies, 50) * 1000, 2),
+        "p90_ms": round(percentile(latencies, 90) * 1000, 2),
+        "p99_ms": round(percentile(latencies, 99) * 1000, 2),
+        "max_ms": round((latencies[-1] if latencies else 0) * 1000, 2),
+        "ops": per_op,
+    }
+    if args.heap:
+        result.update({
+            "heap_before": heap_before,
+            "heap_after": heap_after,
+            "heap_min": min((s[1] for s in samples), default=None),
+            "heap_lost": (heap_before - heap_after) if heap_before is not None and heap_after is not None else None,
+            "heap_slope_per_hour": round(heap_slope(samples), 1),
+            "block_min": min((s[2] for s in samples if s[2] is not None), default=None),
+            "block_slope_per_hour": round(heap_slope(samples, 2), 1),
+            "heap_samples": samples,
+        })
+    return result
+
+
+def compare(baseline, results, threshold, leak_bytes):
+    """Return a list of regression messages against a previous --json file."""
+    problems = []
+    base = {r["clients"]: r for r in baseline.get("results", [])}
+    for r in results:
+        b = base.get(r["clients"])
+        if r.get("heap_lost") is not None and r["heap_lost"] > leak_bytes:
+            problems.append(f"{r['clients']} clients: {r['heap_lost']} bytes of heap not returned")
+        if not b:
+            continue
+        if b["rps"] and (b["rps"] - r["rps"]) * 100.0 / b["rps"] > threshold:
+            problems.append(f"{r['clients']} clients: req/s {b['rps']} -> {r['rps']}")
+        if b["p99_ms"] and (r["p99_ms"] - b["p99_ms"]) * 100.0 / b["p99_ms"] > threshold:
+            problems.append(f"{r['clients']} clients: p99 {b['p99_ms']} ms -> {r['p99_ms']} ms")
+        if r["errors"] > b["errors"]:
+            problems.append(f"{r['clients']} clients: errors {b['errors']} -> {r['errors']}")
+        if b.get("heap_min") and r.get("heap_min") and \
+                (b["heap_min"] - r["heap_min"]) * 100.0 / b["heap_min"] > threshold:
+            problems.append(f"{r['clients']} clients: lowest free heap {b['heap_min']} -> {r['heap_min']}")
+        if b.get("block_min") and r.get("block_min") and \
+                (b["block_min"] - r["block_min"]) * 100.0 / b["block_min"] > threshold:
+            problems.append(f"{r['clients']} clients: smallest largest block {b['block_min']} -> {r['block_min']}")
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="HTTP load and soak generator for ESP32WebConfig")
+    parser.add_argument("host", nargs="?", help="Server address, e.g. 192.168.4.1 or 127.0.0.1")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--path", action="append", help="GET path, repeatable (replaces --mix)")
+    parser.add_argument("--mix", default=DEFAULT_MIX,
+                        help=f"Weighted request mix from {', '.join(REQUESTS)} (default {DEFAULT_MIX})")
+    parser.add_argument("--clients", default="1,4,8", help="Comma-separated concurrency levels")
+    parser.add_argument("--duration", type=float, default=10.0, help="Seconds per concurrency level")
+    parser.add_argument("--soak", type=float, metavar="SECONDS",
+                        help="One long run at the first --clients level with heap progress output")
+    parser.add_argument("--timeout", type=float, default=10.0, help="Per-request socket timeout")
+    parser.add_argument("--user", default="admin")
+    parser.add_argument("--password", help="Default admin, or admin123 for --host-build")
+    parser.add_argument("--host-build", metavar="DIR",
+                        help="Build and start the host program in this CMake build directory")
+    parser.add_argument("--host-sketch", default="BasicUsage", help="Example started by --host-build")
+    parser.add_argument("--host-port-offset", type=int, default=8000,
+                        help="WEBCONFIG_HOST_PORT_OFFSET for --host-build")
+    parser.add_argument("--no-keep-alive", dest="keep_alive", action="store_false",
+                        help="Open a new connection for every request")
+    parser.add_argument("--no-heap", dest="heap", action="store_false", help="Do not sample /api/status")
+    parser.add_argument("--sample-interval", type=float, default=5.0, help="Seconds between heap samples")
+    parser.add_argument("--settle", type=float, default=2.0, help="Idle seconds before the final heap sample")
+    parser.add_argument("--json", help="Write results to this file")
+    parser.add_argument("--baseline", help="Previous --json output; exit 1 on regression")
+    parser.add_argument("--threshold", type=float, default=15.0, help="Allowed regression in percent")
+    parser.add_argument("--leak-bytes", type=int, default=1024,
+                        help="Heap not returned after a level that counts as a leak")
+    args = parser.parse_args()
+
+    server = None
+    if args.host_build:
+        server = HostServer(args.host_build, args.host_sketch, args.host_port_offset)
+        try:
+            server.build()
+            server.start()
+        except (OSError, subprocess.CalledProcessError) as e:
+            print(f"Host build: {e}", file=sys.stderr)
+            return 2
+        args.host, args.port = "127.0.0.1", server.port
+        if args.password is None:
+            args.password = "admin123"
+    elif not args.host:
+        parser.error("a host address or --host-build is required")
+    if args.password is None:
+        args.password = "admin"
+
+    try:
+        return run(args, parser)
+    finally:
+        if server:
+            server.stop()
+
+
+def run(args, parser):
+    token = base64.b64encode(f"{args.user}:{args.password}".encode()).decode()
+    headers = {"Authorization": f"Basic {token}"}
+    device = Device(args, headers)
+
+    try:
+        schedule = args.path or parse_mix(args.mix)
+    except ValueError as e:
+        parser.error(str(e))
+
+    if not args.path:
+        try:
+            missing = [name for name in set(schedule) if not device.available(name)]
+        except (OSError, http.client.HTTPException) as e:
+            print(f"Cannot reach {args.host}:{args.port}: {e}", file=sys.stderr)
+            return 2
+        for name in sorted(missing):
+            print(f"Skipping '{name}', not served by this firmware")
+        schedule = [name for name in schedule if name not in missing]
+        if not schedule:
+            print("Nothing left in the request mix", file=sys.stderr)
+            return 2
+
+    save_body = None
+    if "save" in schedule:
+        try:
+            save_body = device.save_body()
+        except (OSError, http.client.HTTPException, ValueError) as e:
+            print(f"Cannot read /api/config for /save posts: {e}", file=sys.stderr)
+            return 2
+
+    levels = [int(c) for c in args.clients.split(",")]
+    progress = None
+    if args.soak:
+        args.duration = args.soak
+        levels = levels[:1]
+        progress = lambda s: print(f"  t={s[0]:>8.1f}s free_heap={s[1]} largest_block={s[2]}", flush=True)
+
+    results = []
+    for level in levels:
+        r = run_level(args, level, schedule, headers, device, save_body, progress)
+        results.append(r)
+
+    print(f"{'clients':>7} {'requests':>9} {'errors':>7} {'req/s':>8} {'p50 ms':>8} {'p99 ms':>8} {'max ms':>8}"
+          + (f" {'heap min':>9} {'heap lost':>9} {'B/hour':>9} {'block min':>9} {'B/hour':>9}" if args.heap else ""))
+    for r in results:
+        line = (f"{r['clients']:>7} {r['requests']:>9} {r['errors']:>7} {r['rps']:>8} "
+                f"{r['p50_ms']:>8} {r['p99_ms']:>8} {r['max_ms']:>8}")
+        if args.heap:
+            line += (f" {str(r['heap_min']):>9} {str(r['heap_lost']):>9} {r['heap_slope_per_hour']:>9}"
+                     f" {str(r['block_min']):>9} {r['block_slope_per_hour']:>9}")
+        print(line)
+        for name, op in r["ops"].items():
+            print(f"{'':>7} {name:<9} {op['requests']:>7} requests  p50 {op['p50_ms']} ms  p99 {op['p99_ms']} ms")
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"host": args.host, "schedule": schedule, "keep_alive": args.keep_alive,
+                       "results": results}, f, indent=2)
+
+    status = 1 if any(r["requests"] == 0 for r in results) else 0
+    if args.host_build and any(r["errors"] for r in results):
+        print("Failed requests against the host build")
+        status = 1
+    if args.baseline:
+        with open(args.baseline) as f:
+            problems = compare(json.load(f), results, args.threshold, args.leak_bytes)
+        for p in problems:
+            print("REGRESSION: " + p)
+        print(f"{len(problems)} regression(s) against {args.baseline}")
+        if problems:
+            status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
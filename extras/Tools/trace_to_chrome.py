@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+ESP32WebConfig trace converter
+
+Converts the binary dump from /api/trace into Chrome trace JSON, which
+opens in chrome://tracing or https://ui.perfetto.dev. Begin/end pairs
+become complete ("X") events, WiFi events become instants.
+
+Examples:
+    curl -u admin:admin -o trace.bin http://192.168.4.1/api/trace
+    python3 trace_to_chrome.py trace.bin -o trace.json
+    python3 trace_to_chrome.py http://192.168.4.1/api/trace --user admin --password admin -o trace.json
+
+Author: ZONIO Project Team
+License: MIT
+"""
+
+import argparse
+import base64
+import json
+import struct
+import sys
+import urllib.request
+
+MAGIC = b"WCTR"
+HEADER = struct.Struct("<4sBBHII")
+EVENT = struct.Struct("<IBBH")
+WRAP = 1 << 32
+
+
+def read_source(source, user=None, password=None):
+    if source.startswith("http://") or source.startswith("https://"):
+        request = urllib.request.Request(source)
+        if user:
+            token = base64.b64encode(f"{user}:{password or ''}".encode()).decode()
+            request.add_header("Authorization", "Basic " + token)
+        with urllib.request.urlopen(request, timeout=10) as response:
+            return response.read()
+    with open(source, "rb") as f:
+        return f.read()
+
+
+def parse(data):
+    """Return (names, events, dropped); event timestamps are unwrapped to 64 bit."""
+    magic, version, event_size, name_count, event_count, dropped = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("not an ESP32WebConfig trace (bad magic)")
+    if version != 1 or event_size != EVENT.size:
+        raise ValueError(f"unsupported trace version {version} / event size {event_size}")
+
+    offset = HEADER.size
+    names = []
+    for _ in range(name_count):
+        length = data[offset]
+        names.append(data[offset + 1:offset + 1 + length].decode("ascii", "replace"))
+        offset += 1 + length
+
+    events = []
+    base = 0
+    last = None
+    for i in range(event_count):
+        ts, ident, phase, arg = EVENT.unpack_from(data, offset + i * EVENT.size)
+        # micros() wraps every ~71 minutes; deferred spans may step back a little
+        if last is not None and ts < last and last - ts > WRAP // 2:
+            base += WRAP
+        last = ts
+        name = names[ident] if ident < len(names) else f"id{ident}"
+        events.append((base + ts, name, chr(phase), arg))
+    return names, events, dropped
+
+
+def to_chrome(events, pid=1, tid=1):
+    out = [{"name": "thread_name", "ph": "M", "pid": pid, "tid": tid, "args": {"name": "loop"}}]
+    open_spans = {}
+    for ts, name, phase, arg in events:
+        if phase == "B":
+            open_spans.setdefault(name, []).append(ts)
+        elif phase == "E":
+            stack = open_spans.get(name)
+            if not stack:
+                continue    # Begin was overwritten in the ring
+            start = stack.pop()
+            out.append({"name": name, "ph": "X", "ts": start, "dur": max(ts - start, 0), "pid": pid, "tid": tid})
+        else:
+            out.append({"name": name, "ph": "i", "s": "t", "ts": ts, "pid": pid, "tid": tid, "args": {"arg": arg}})
+
+    # Spans still running when the dump was taken
+    for name, stack in open_spans.items():
+        for start in stack:
+            out.append({"name": name, "ph": "B", "ts": start, "pid": pid, "tid": tid})
+
+    out.sort(key=lambda e: e.get("ts", -1))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an ESP32WebConfig trace dump to Chrome trace JSON")
+    parser.add_argument("source", help="trace.bin file or http://device/api/trace URL")
+    parser.add_argument("-o", "--output", help="Output file (default stdout)")
+    parser.add_argument("--user", help="HTTP auth user when fetching from a device")
+    parser.add_argument("--password", help="HTTP auth password")
+    args = parser.parse_args()
+
+    try:
+        _, events, dropped = parse(read_source(args.source, args.user, args.password))
+    except (OSError, ValueError, struct.error) as e:
+        print(f"Cannot read trace: {e}", file=sys.stderr)
+        return 2
+
+    trace = {"traceEvents": to_chrome(events), "displayTimeUnit": "ms",
+             "otherData": {"dropped_events": dropped}}
+    text = json.dumps(trace, indent=1)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        print(text)
+
+    print(f"{len(events)} events, {dropped} dropped before the dump", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,79 @@
+/*
+ * ESP32WebConfig Library - Host Allocation Test
+ * ctest counterpart of examples/AllocCheck: the typed getters, handle reads,
+ * setting a handle to its current value and an idle handle() must not
+ * allocate. Exits with 1 when any of them does, 0 when all pass.
+ *
+ * Built against webconfig_alloc, where operator new/delete and the wrapped
+ * C allocator feed WebConfigAlloc. A control check that has to allocate
+ * makes sure the counting is live, so a missing hook cannot pass.
+ *
+ * Output: ALLOC,<check>,<iterations>,<allocations>,<PASS|FAIL>
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigHost.h"
+#include <ESP32WebConfig.h>
+
+static const int ITERATIONS = 1000;
+
+static bool allPassed = true;
+
+// Runs body() iterations times; expectAlloc selects the control check
+template <typename Body>
+static void check(const char* name, bool expectAlloc, Body body) {
+    uint32_t before = WebConfigAlloc::getTaskCount();
+    for (int i = 0; i < ITERATIONS; i++) {
+        body();
+    }
+    uint32_t allocations = WebConfigAlloc::getTaskCount() - before;
+    bool pass = expectAlloc ? allocations > 0 : allocations == 0;
+    allPassed &= pass;
+    printf("ALLOC,%s,%d,%lu,%s\n", name, ITERATIONS, (unsigned long)allocations, pass ? "PASS" : "FAIL");
+}
+
+int main(int argc, char** argv) {
+    webConfigHostBegin(argc, argv);
+
+    if (!WebConfigAlloc::isActive()) {
+        printf("No allocator hook compiled in\n");
+        return 1;
+    }
+
+    ESP32WebConfig config;
+    config.setDeviceName("AllocTest");
+    config.setAPConfig("AllocTest-Setup", "12345678");
+    ParamHandle<int> intervalHandle = config.addNumberParameter("interval", "Interval (s)", 60, 1, 3600);
+    ParamHandle<float> offsetHandle = config.addFloatParameter("offset", "Offset", 0.5);
+    ParamHandle<bool> enabledHandle = config.addCheckboxParameter("enabled", "Enabled", true);
+    config.addTextParameter("mqtt_topic", "MQTT topic", "sensors/outdoor/temperature");
+    config.begin();
+
+    // Same settling as the sketch: the first passes start the captive DNS
+    for (int i = 0; i < 100; i++) {
+        config.handle();
+    }
+    WebConfigAlloc::reset();
+
+    volatile long sink = 0;
+    check("getInt", false, [&]() { sink += config.getInt("interval"); });
+    check("getFloat", false, [&]() { sink += (long)config.getFloat("offset"); });
+    check("getBool", false, [&]() { sink += config.getBool("enabled"); });
+    check("get_handle", false, [&]() {
+        sink += config.get(intervalHandle) + (long)config.get(offsetHandle) + config.get(enabledHandle);
+    });
+    check("set_handle_same", false, [&]() {
+        config.set(intervalHandle, 60);
+        config.set(offsetHandle, 0.5f);
+        config.set(enabledHandle, true);
+    });
+    check("handle_idle", false, [&]() { config.handle(); });
+
+    // Longer than the String small buffer, so every copy allocates
+    check("control_getValue", true, [&]() { sink += config.getValue("mqtt_topic").length(); });
+
+    printf("ALLOC_RESULT,%s\n", allPassed ? "PASS" : "FAIL");
+    return allPassed ? 0 : 1;
+}
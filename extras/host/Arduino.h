@@ -0,0 +1,14 @@
+/*
+ * ESP32WebConfig Library - Host Arduino Header
+ * Lets sketches and ArduinoJson include <Arduino.h> in the host build
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGHOST_ARDUINO_H
+#define WEBCONFIGHOST_ARDUINO_H
+
+#include "WebConfigHost.h"
+
+#endif // WEBCONFIGHOST_ARDUINO_H
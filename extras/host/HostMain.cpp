@@ -0,0 +1,39 @@
+/*
+ * ESP32WebConfig Library - Host Sketch Runner
+ * main() for examples built as host programs: setup() once, then loop()
+ * until SIGINT or SIGTERM
+ *
+ * Usage: <Sketch> [--duration SECONDS]
+ *   --duration  stop after this many seconds of loop(); 0 runs setup() only
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigHost.h"
+
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+    webConfigHostBegin(argc, argv);
+
+    long duration = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            duration = strtol(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [--duration SECONDS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+    unsigned long start = millis();
+    while (!webConfigHostStopped()) {
+        if (duration >= 0 && millis() - start >= (unsigned long)duration * 1000UL) break;
+        loop();
+    }
+    Serial.flush();
+    return 0;
+}
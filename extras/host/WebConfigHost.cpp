@@ -0,0 +1,1611 @@
+/*
+ * ESP32WebConfig Library - Host Platform Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigHost.h"
+
+#include <chrono>
+#include <thread>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#if defined(__GLIBC__)
+  #include <malloc.h>
+#endif
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+MDNSResponder MDNS;
+EEPROMClass EEPROM;
+
+// ===== HOST CONTROL =====
+
+static char** hostArgv = nullptr;
+static volatile sig_atomic_t hostStopped = 0;
+
+static void hostSignal(int signal) {
+    (void)signal;
+    hostStopped = 1;
+}
+
+void webConfigHostBegin(int argc, char** argv) {
+    (void)argc;
+    hostArgv = argv;
+    signal(SIGINT, hostSignal);
+    signal(SIGTERM, hostSignal);
+    // A client that hangs up mid-response must not end the process
+    signal(SIGPIPE, SIG_IGN);
+}
+
+bool webConfigHostStopped() {
+    return hostStopped != 0;
+}
+
+uint16_t webConfigHostPort(uint16_t devicePort) {
+    static long offset = -1;
+    if (offset < 0) {
+        const char* env = getenv("WEBCONFIG_HOST_PORT_OFFSET");
+        offset = env ? strtol(env, nullptr, 10) : WEBCONFIG_HOST_PORT_OFFSET;
+        if (offset < 0) offset = 0;
+    }
+    return (uint16_t)(devicePort + offset);
+}
+
+// ===== ARDUINO CORE =====
+
+static const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+}
+
+unsigned long millis() {
+    return micros() / 1000;
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+static uint8_t pinLevels[64];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < sizeof(pinLevels)) pinLevels[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW;
+}
+
+uint16_t analogRead(uint8_t pin) {
+    (void)pin;
+    return 0;
+}
+
+long random(long howbig) {
+    return howbig > 0 ? (long)(::random() % howbig) : 0;
+}
+
+long random(long howsmall, long howbig) {
+    return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed) srandom((unsigned int)seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    if (in_max == in_min) return out_min;
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// ===== STRING =====
+
+void String::init() {
+    ptr = nullptr;
+    len = 0;
+    capacity = SSO_SIZE - 1;
+    sso[0] = '\0';
+}
+
+String::String(const char* cstr) {
+    init();
+    if (cstr) copy(cstr, strlen(cstr));
+}
+
+String::String(const char* cstr, unsigned int length) {
+    init();
+    if (cstr) copy(cstr, length);
+}
+
+String::String(const String& str) {
+    init();
+    copy(str.c_str(), str.len);
+}
+
+String::String(const __FlashStringHelper* str) {
+    init();
+    if (str) copy((const char*)str, strlen((const char*)str));
+}
+
+String::String(String&& rval) {
+    init();
+    move(rval);
+}
+
+String::String(char c) {
+    init();
+    sso[0] = c;
+    sso[1] = '\0';
+    len = 1;
+}
+
+String::String(unsigned char value, unsigned char base) {
+    init();
+    setNumber(value, base, false);
+}
+
+String::String(int value, unsigned char base) {
+    init();
+    bool negative = value < 0 && base == 10;
+    setNumber(negative ? 0ULL - (unsigned long long)value : (unsigned int)value, base, negative);
+}
+
+String::String(unsigned int value, unsigned char base) {
+    init();
+    setNumber(value, base, false);
+}
+
+String::String(long value, unsigned char base) {
+    init();
+    bool negative = value < 0 && base == 10;
+    setNumber(negative ? 0ULL - (unsigned long long)value : (unsigned long)value, base, negative);
+}
+
+String::String(unsigned long value, unsigned char base) {
+    init();
+    setNumber(value, base, false);
+}
+
+String::String(long long value, unsigned char base) {
+    init();
+    bool negative = value < 0 && base == 10;
+    setNumber(negative ? 0ULL - (unsigned long long)value : (unsigned long long)value, base, negative);
+}
+
+String::String(unsigned long long value, unsigned char base) {
+    init();
+    setNumber(value, base, false);
+}
+
+String::String(float value, unsigned int decimalPlaces) {
+    init();
+    concatNumber("%.*f", (int)decimalPlaces, (double)value);
+}
+
+String::String(double value, unsigned int decimalPlaces) {
+    init();
+    concatNumber("%.*f", (int)decimalPlaces, value);
+}
+
+String::~String() {
+    free(ptr);
+}
+
+void String::setNumber(unsigned long long value, unsigned char base, bool negative) {
+    if (base < 2 || base > 36) base = 10;
+    char digits[66];
+    char* p = digits + sizeof(digits) - 1;
+    *p = '\0';
+    do {
+        unsigned digit = (unsigned)(value % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value);
+    if (negative) *--p = '-';
+    copy(p, (unsigned int)(digits + sizeof(digits) - 1 - p));
+}
+
+bool String::concatNumber(const char* format, ...) {
+    char text[352];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (n < 0) return false;
+    return concat(text, (unsigned int)std::min<int>(n, sizeof(text) - 1));
+}
+
+// Sized to the request like the ESP32 core, so appending without reserve()
+// reallocates on every call there as well
+bool String::changeBuffer(unsigned int maxStrLen) {
+    if (maxStrLen < SSO_SIZE) {
+        if (ptr) {
+            memcpy(sso, ptr, len + 1);
+            free(ptr);
+            ptr = nullptr;
+        }
+        capacity = SSO_SIZE - 1;
+        return true;
+    }
+    char* fresh = (char*)realloc(ptr, maxStrLen + 1);
+    if (!fresh) return false;
+    if (!ptr) memcpy(fresh, sso, len + 1);
+    ptr = fresh;
+    capacity = maxStrLen;
+    return true;
+}
+
+bool String::reserve(unsigned int size) {
+    if (size <= capacity) return true;
+    return changeBuffer(size);
+}
+
+void String::clear() {
+    len = 0;
+    wbuffer()[0] = '\0';
+}
+
+String& String::copy(const char* cstr, unsigned int length) {
+    if (!reserve(length)) {
+        clear();
+        return *this;
+    }
+    memmove(wbuffer(), cstr, length);
+    len = length;
+    wbuffer()[len] = '\0';
+    return *this;
+}
+
+void String::move(String& rhs) {
+    if (this == &rhs) return;
+    free(ptr);
+    ptr = rhs.ptr;
+    len = rhs.len;
+    capacity = rhs.capacity;
+    memcpy(sso, rhs.sso, sizeof(sso));
+    rhs.init();
+}
+
+String& String::operator=(const String& rhs) {
+    if (this != &rhs) copy(rhs.c_str(), rhs.len);
+    return *this;
+}
+
+String& String::operator=(const char* cstr) {
+    if (cstr) copy(cstr, strlen(cstr));
+    else clear();
+    return *this;
+}
+
+String& String::operator=(const __FlashStringHelper* str) {
+    return *this = (const char*)str;
+}
+
+String& String::operator=(String&& rval) {
+    move(rval);
+    return *this;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (!cstr) return false;
+    if (length == 0) return true;
+    unsigned int newLen = len + length;
+    // cstr may point into this string
+    if (cstr >= c_str() && cstr < c_str() + capacity + 1) {
+        size_t offset = cstr - c_str();
+        if (!reserve(newLen)) return false;
+        cstr = c_str() + offset;
+    } else if (!reserve(newLen)) {
+        return false;
+    }
+    memmove(wbuffer() + len, cstr, length);
+    len = newLen;
+    wbuffer()[len] = '\0';
+    return true;
+}
+
+bool String::concat(const String& str) { return concat(str.c_str(), str.len); }
+bool String::concat(const char* cstr) { return cstr && concat(cstr, strlen(cstr)); }
+bool String::concat(const __FlashStringHelper* str) { return concat((const char*)str); }
+bool String::concat(char c) { return concat(&c, 1); }
+bool String::concat(unsigned char num) { return concatNumber("%u", (unsigned)num); }
+bool String::concat(int num) { return concatNumber("%d", num); }
+bool String::concat(unsigned int num) { return concatNumber("%u", num); }
+bool String::concat(long num) { return concatNumber("%ld", num); }
+bool String::concat(unsigned long num) { return concatNumber("%lu", num); }
+bool String::concat(long long num) { return concatNumber("%lld", num); }
+bool String::concat(unsigned long long num) { return concatNumber("%llu", num); }
+bool String::concat(float num) { return concatNumber("%.2f", (double)num); }
+bool String::concat(double num) { return concatNumber("%.2f", num); }
+
+#define WC_HOST_SUM(type)                                                            \
+    StringSumHelper& operator+(const StringSumHelper& lhs, type rhs) {               \
+        StringSumHelper& a = const_cast<StringSumHelper&>(lhs);                      \
+        a.concat(rhs);                                                               \
+        return a;                                                                    \
+    }
+WC_HOST_SUM(const String&)
+WC_HOST_SUM(const char*)
+WC_HOST_SUM(const __FlashStringHelper*)
+WC_HOST_SUM(char)
+WC_HOST_SUM(unsigned char)
+WC_HOST_SUM(int)
+WC_HOST_SUM(unsigned int)
+WC_HOST_SUM(long)
+WC_HOST_SUM(unsigned long)
+WC_HOST_SUM(long long)
+WC_HOST_SUM(unsigned long long)
+WC_HOST_SUM(float)
+WC_HOST_SUM(double)
+#undef WC_HOST_SUM
+
+int String::compareTo(const String& s) const {
+    return strcmp(c_str(), s.c_str());
+}
+
+bool String::equals(const String& s) const {
+    return len == s.len && memcmp(c_str(), s.c_str(), len) == 0;
+}
+
+bool String::equals(const char* cstr) const {
+    if (!cstr) return len == 0;
+    return strcmp(c_str(), cstr) == 0;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    return len == s.len && strcasecmp(c_str(), s.c_str()) == 0;
+}
+
+bool String::equalsConstantTime(const String& s) const {
+    if (len != s.len) return false;
+    uint8_t diff = 0;
+    for (unsigned int i = 0; i < len; i++) diff |= (uint8_t)(c_str()[i] ^ s.c_str()[i]);
+    return diff == 0;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > len || prefix.len > len - offset) return false;
+    return memcmp(c_str() + offset, prefix.c_str(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.len > len) return false;
+    return memcmp(c_str() + len - suffix.len, suffix.c_str(), suffix.len) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return operator[](index);
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < len) wbuffer()[index] = c;
+}
+
+char String::operator[](unsigned int index) const {
+    return index < len ? c_str()[index] : '\0';
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= len) {
+        dummy = '\0';
+        return dummy;
+    }
+    return wbuffer()[index];
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index) const {
+    if (!bufsize || !buf) return;
+    if (index >= len) {
+        buf[0] = '\0';
+        return;
+    }
+    unsigned int n = std::min(bufsize - 1, len - index);
+    memcpy(buf, c_str() + index, n);
+    buf[n] = '\0';
+}
+
+int String::indexOf(char ch) const {
+    return indexOf(ch, 0);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    if (fromIndex >= len) return -1;
+    const char* found = (const char*)memchr(c_str() + fromIndex, ch, len - fromIndex);
+    return found ? (int)(found - c_str()) : -1;
+}
+
+int String::indexOf(const String& str) const {
+    return indexOf(str, 0);
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    if (fromIndex > len) return -1;
+    const char* found = strstr(c_str() + fromIndex, str.c_str());
+    return found ? (int)(found - c_str()) : -1;
+}
+
+int String::lastIndexOf(char ch) const {
+    return len ? lastIndexOf(ch, len - 1) : -1;
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+    if (!len) return -1;
+    if (fromIndex >= len) fromIndex = len - 1;
+    for (int i = (int)fromIndex; i >= 0; i--) {
+        if (c_str()[i] == ch) return i;
+    }
+    return -1;
+}
+
+int String::lastIndexOf(const String& str) const {
+    return len >= str.len ? lastIndexOf(str, len - str.len) : -1;
+}
+
+int String::lastIndexOf(const String& str, unsigned int fromIndex) const {
+    if (str.len == 0 || str.len > len) return -1;
+    if (fromIndex > len - str.len) fromIndex = len - str.len;
+    for (int i = (int)fromIndex; i >= 0; i--) {
+        if (memcmp(c_str() + i, str.c_str(), str.len) == 0) return i;
+    }
+    return -1;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= len) return String();
+    if (endIndex > len) endIndex = len;
+    return String(c_str() + beginIndex, endIndex - beginIndex);
+}
+
+void String::replace(char find, char replace) {
+    char* p = wbuffer();
+    for (unsigned int i = 0; i < len; i++) {
+        if (p[i] == find) p[i] = replace;
+    }
+}
+
+void String::replace(const String& find, const String& replace) {
+    if (len == 0 || find.len == 0) return;
+    String result;
+    const char* start = c_str();
+    const char* found;
+    bool changed = false;
+    while ((found = strstr(start, find.c_str())) != nullptr) {
+        result.concat(start, (unsigned int)(found - start));
+        result.concat(replace);
+        start = found + find.len;
+        changed = true;
+    }
+    if (!changed) return;
+    result.concat(start);
+    *this = static_cast<String&&>(result);
+}
+
+void String::remove(unsigned int index) {
+    remove(index, (unsigned int)-1);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index >= len || count == 0) return;
+    if (count > len - index) count = len - index;
+    char* p = wbuffer();
+    memmove(p + index, p + index + count, len - index - count + 1);
+    len -= count;
+}
+
+void String::toLowerCase() {
+    char* p = wbuffer();
+    for (unsigned int i = 0; i < len; i++) p[i] = (char)tolower((unsigned char)p[i]);
+}
+
+void String::toUpperCase() {
+    char* p = wbuffer();
+    for (unsigned int i = 0; i < len; i++) p[i] = (char)toupper((unsigned char)p[i]);
+}
+
+void String::trim() {
+    if (!len) return;
+    char* p = wbuffer();
+    unsigned int begin = 0;
+    while (begin < len && isspace((unsigned char)p[begin])) begin++;
+    unsigned int end = len;
+    while (end > begin && isspace((unsigned char)p[end - 1])) end--;
+    len = end - begin;
+    memmove(p, p + begin, len);
+    p[len] = '\0';
+}
+
+long String::toInt() const {
+    return atol(c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(c_str());
+}
+
+double String::toDouble() const {
+    return atof(c_str());
+}
+
+// ===== SERIAL =====
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    if ((size_t)n < sizeof(text)) return write((const uint8_t*)text, n);
+
+    char* large = (char*)malloc(n + 1);
+    if (!large) return 0;
+    va_start(args, format);
+    vsnprintf(large, n + 1, format, args);
+    va_end(args);
+    size_t written = write((const uint8_t*)large, n);
+    free(large);
+    return written;
+}
+
+size_t Print::print(long long num, int base) {
+    if (base == 10 && num < 0) return print('-') + print(0ULL - (unsigned long long)num, base);
+    return print((unsigned long long)num, base);
+}
+
+size_t Print::print(unsigned long long num, int base) {
+    if (base < 2 || base > 36) base = 10;
+    char digits[65];
+    char* p = digits + sizeof(digits) - 1;
+    *p = '\0';
+    do {
+        unsigned digit = (unsigned)(num % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        num /= base;
+    } while (num);
+    return write(p);
+}
+
+size_t Print::print(double num, int digits) {
+    char text[352];
+    int n = snprintf(text, sizeof(text), "%.*f", digits, num);
+    return n > 0 ? write((const uint8_t*)text, std::min<size_t>(n, sizeof(text) - 1)) : 0;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+// ===== ESP =====
+
+// Heap in use by this process; what was in use before main() does not count
+static size_t hostHeapInUse() {
+    #if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+    #elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return (size_t)(unsigned)info.uordblks + (size_t)(unsigned)info.hblkhd;
+    #else
+    return 0;
+    #endif
+}
+
+static size_t hostHeapBaseline = 0;
+static uint32_t hostMinFreeHeap = WEBCONFIG_HOST_HEAP_SIZE;
+
+__attribute__((constructor(101))) static void hostHeapInit() {
+    hostHeapBaseline = hostHeapInUse();
+}
+
+uint32_t EspClass::getFreeHeap() {
+    size_t used = hostHeapInUse();
+    used = used > hostHeapBaseline ? used - hostHeapBaseline : 0;
+    uint32_t freeHeap = used < WEBCONFIG_HOST_HEAP_SIZE ? (uint32_t)(WEBCONFIG_HOST_HEAP_SIZE - used) : 0;
+    if (freeHeap < hostMinFreeHeap) hostMinFreeHeap = freeHeap;
+    return freeHeap;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    getFreeHeap();
+    return hostMinFreeHeap;
+}
+
+uint32_t EspClass::getCpuFreqMHz() {
+    static uint32_t mhz = 0;
+    if (!mhz) {
+        FILE* f = fopen("/proc/cpuinfo", "r");
+        if (f) {
+            char line[256];
+            double value;
+            while (fgets(line, sizeof(line), f)) {
+                if (sscanf(line, "cpu MHz : %lf", &value) == 1) {
+                    mhz = (uint32_t)value;
+                    break;
+                }
+            }
+            fclose(f);
+        }
+        if (!mhz) mhz = 1000;
+    }
+    return mhz;
+}
+
+uint32_t EspClass::getCycleCount() {
+    unsigned long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+    return (uint32_t)(ns * getCpuFreqMHz() / 1000);
+}
+
+uint8_t* EspClass::random(uint8_t* resultArray, size_t outputSizeBytes) {
+    size_t filled = 0;
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd >= 0) {
+        while (filled < outputSizeBytes) {
+            ssize_t n = ::read(fd, resultArray + filled, outputSizeBytes - filled);
+            if (n <= 0) break;
+            filled += n;
+        }
+        ::close(fd);
+    }
+    while (filled < outputSizeBytes) resultArray[filled++] = (uint8_t)::random();
+    return resultArray;
+}
+
+void EspClass::restart() {
+    Serial.flush();
+    if (hostArgv && hostArgv[0]) execv(hostArgv[0], hostArgv);
+    exit(0);
+}
+
+// ===== NETWORK =====
+
+bool IPAddress::fromString(const char* address) {
+    unsigned parts[4];
+    char tail;
+    if (!address || sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail) != 4) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (parts[i] > 255) return false;
+        bytes[i] = (uint8_t)parts[i];
+    }
+    return true;
+}
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(text);
+}
+
+static IPAddress hostLoopback() {
+    return IPAddress(127, 0, 0, 1);
+}
+
+WiFiClass::WiFiClass() : apIP(192, 168, 4, 1) {
+    for (auto& h : handlers) h.id = 0;
+    nextEventId = 1;
+    currentMode = WIFI_MODE_NULL;
+    staStatus = WL_IDLE_STATUS;
+    stations = 0;
+}
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+    if ((currentMode == WIFI_MODE_AP || currentMode == WIFI_MODE_APSTA) &&
+        mode != WIFI_MODE_AP && mode != WIFI_MODE_APSTA) {
+        raise(ARDUINO_EVENT_WIFI_AP_STOP);
+    }
+    if ((currentMode == WIFI_MODE_STA || currentMode == WIFI_MODE_APSTA) &&
+        mode != WIFI_MODE_STA && mode != WIFI_MODE_APSTA) {
+        disconnect();
+    }
+    currentMode = mode;
+    return true;
+}
+
+bool WiFiClass::softAPConfig(IPAddress localIP, IPAddress gateway, IPAddress subnet) {
+    (void)gateway;
+    (void)subnet;
+    apIP = localIP;
+    return true;
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* passphrase, int channel, int hidden, int maxConnection) {
+    (void)channel;
+    (void)hidden;
+    (void)maxConnection;
+    if (!ssid || !*ssid) return false;
+    if (passphrase && *passphrase && strlen(passphrase) < 8) return false;
+    if (currentMode != WIFI_MODE_AP && currentMode != WIFI_MODE_APSTA) {
+        currentMode = currentMode == WIFI_MODE_STA ? WIFI_MODE_APSTA : WIFI_MODE_AP;
+    }
+    apSSID = ssid;
+    raise(ARDUINO_EVENT_WIFI_AP_START);
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifioff) {
+    setStationCount(0);
+    raise(ARDUINO_EVENT_WIFI_AP_STOP);
+    apSSID = String();
+    if (wifioff) currentMode = currentMode == WIFI_MODE_APSTA ? WIFI_MODE_STA : WIFI_MODE_NULL;
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase) {
+    (void)passphrase;
+    if (!ssid || !*ssid) {
+        staStatus = WL_CONNECT_FAILED;
+        return staStatus;
+    }
+    if (currentMode != WIFI_MODE_STA && currentMode != WIFI_MODE_APSTA) {
+        currentMode = currentMode == WIFI_MODE_AP ? WIFI_MODE_APSTA : WIFI_MODE_STA;
+    }
+    staSSID = ssid;
+    staStatus = WL_CONNECTED;
+    raise(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    raise(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    return staStatus;
+}
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet) {
+    (void)gateway;
+    (void)subnet;
+    staIP = localIP;
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifioff) {
+    bool wasConnected = staStatus == WL_CONNECTED;
+    staStatus = WL_DISCONNECTED;
+    if (wasConnected) raise(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    if (wifioff) currentMode = currentMode == WIFI_MODE_APSTA ? WIFI_MODE_AP : WIFI_MODE_NULL;
+    return true;
+}
+
+IPAddress WiFiClass::localIP() const {
+    // The web server is reachable on loopback whatever address was configured
+    return staStatus == WL_CONNECTED ? hostLoopback() : IPAddress();
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb callback, arduino_event_id_t event) {
+    for (auto& h : handlers) {
+        if (h.id == 0) {
+            h.callback = callback;
+            h.event = event;
+            h.id = nextEventId++;
+            return h.id;
+        }
+    }
+    return 0;
+}
+
+void WiFiClass::removeEvent(wifi_event_id_t id) {
+    for (auto& h : handlers) {
+        if (id && h.id == id) {
+            h.id = 0;
+            h.callback = nullptr;
+        }
+    }
+}
+
+void WiFiClass::setStationCount(uint8_t count) {
+    while (stations < count) {
+        stations++;
+        raise(ARDUINO_EVENT_WIFI_AP_STACONNECTED);
+    }
+    while (stations > count) {
+        stations--;
+        raise(ARDUINO_EVENT_WIFI_AP_STADISCONNECTED);
+    }
+}
+
+void WiFiClass::raise(arduino_event_id_t event) {
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+    for (auto& h : handlers) {
+        if (h.id && h.callback && (h.event == ARDUINO_EVENT_MAX || h.event == event)) {
+            h.callback(event, info);
+        }
+    }
+}
+
+static int hostSocket(int type, uint16_t devicePort) {
+    int fd = socket(AF_INET, type, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(webConfigHostPort(devicePort));
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "WebConfigHost: Cannot bind 127.0.0.1:%u: %s\n",
+                (unsigned)webConfigHostPort(devicePort), strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+WiFiUDP::WiFiUDP() {
+    fd = -1;
+    rxLength = rxPos = txLength = 0;
+    remotePortNumber = txPort = 0;
+}
+
+WiFiUDP::~WiFiUDP() {
+    stop();
+}
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+    stop();
+    fd = hostSocket(SOCK_DGRAM, port);
+    return fd >= 0 ? 1 : 0;
+}
+
+void WiFiUDP::stop() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    rxLength = rxPos = txLength = 0;
+}
+
+int WiFiUDP::parsePacket() {
+    rxLength = rxPos = 0;
+    if (fd < 0) return 0;
+    struct sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    ssize_t n = recvfrom(fd, rx, sizeof(rx), 0, (struct sockaddr*)&from, &fromLength);
+    if (n <= 0) return 0;
+    rxLength = n;
+    remoteAddress = IPAddress((uint32_t)from.sin_addr.s_addr);
+    remotePortNumber = ntohs(from.sin_port);
+    return (int)n;
+}
+
+int WiFiUDP::read() {
+    return rxPos < rxLength ? rx[rxPos++] : -1;
+}
+
+int WiFiUDP::read(uint8_t* buffer, size_t len) {
+    size_t n = std::min(len, rxLength - rxPos);
+    memcpy(buffer, rx + rxPos, n);
+    rxPos += n;
+    return (int)n;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+    txAddress = ip;
+    txPort = port;
+    txLength = 0;
+    return fd >= 0 ? 1 : 0;
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size) {
+    size_t n = std::min(size, sizeof(tx) - txLength);
+    memcpy(tx + txLength, buffer, n);
+    txLength += n;
+    return n;
+}
+
+int WiFiUDP::endPacket() {
+    if (fd < 0) return 0;
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = (uint32_t)txAddress;
+    to.sin_port = htons(txPort);
+    ssize_t n = sendto(fd, tx, txLength, 0, (struct sockaddr*)&to, sizeof(to));
+    txLength = 0;
+    return n >= 0 ? 1 : 0;
+}
+
+DNSServer::DNSServer() {
+    errorReplyCode = DNSReplyCode::NonExistentDomain;
+    ttl = 60;
+}
+
+bool DNSServer::start(const uint16_t& port, const String& domainName, const IPAddress& resolvedIP) {
+    this->domainName = domainName;
+    this->domainName.toLowerCase();
+    this->resolvedIP = resolvedIP;
+    return udp.begin(port) == 1;
+}
+
+void DNSServer::stop() {
+    udp.stop();
+}
+
+// Compares the first question name with the configured domain
+bool DNSServer::matchesDomain(size_t length) const {
+    if (domainName == "*") return true;
+    char name[256];
+    size_t out = 0;
+    size_t pos = 12;
+    while (pos < length && packet[pos]) {
+        uint8_t label = packet[pos++];
+        if (label > 63 || pos + label > length || out + label + 1 >= sizeof(name)) return false;
+        if (out) name[out++] = '.';
+        for (uint8_t i = 0; i < label; i++) name[out++] = (char)tolower(packet[pos++]);
+    }
+    name[out] = '\0';
+    return domainName == name;
+}
+
+void DNSServer::processNextRequest() {
+    int length = udp.parsePacket();
+    if (length < 12) {
+        udp.flush();
+        return;
+    }
+    if (length > (int)sizeof(packet)) length = sizeof(packet);
+    udp.read(packet, length);
+
+    // Queries only, exactly one question
+    if ((packet[2] & 0x80) || packet[4] != 0 || packet[5] != 1) return;
+
+    // End of the question: name, type, class
+    size_t end = 12;
+    while (end < (size_t)length && packet[end]) end += packet[end] + 1;
+    end += 5;
+    if (end > (size_t)length) return;
+    uint16_t type = (packet[end - 4] << 8) | packet[end - 3];
+
+    packet[2] = 0x84 | (packet[2] & 0x01);  // Response, authoritative, keep RD
+    packet[3] = 0x80;                       // RA
+    packet[6] = packet[7] = 0;
+    packet[8] = packet[9] = packet[10] = packet[11] = 0;
+
+    size_t responseLength = end;
+    if (type == 1 && matchesDomain(length) && end + 16 <= sizeof(packet)) {
+        uint8_t answer[16] = {
+            0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01,
+            (uint8_t)(ttl >> 24), (uint8_t)(ttl >> 16), (uint8_t)(ttl >> 8), (uint8_t)ttl,
+            0x00, 0x04, resolvedIP[0], resolvedIP[1], resolvedIP[2], resolvedIP[3]
+        };
+        memcpy(packet + end, answer, sizeof(answer));
+        packet[7] = 1;
+        responseLength += sizeof(answer);
+    } else {
+        packet[3] |= (uint8_t)errorReplyCode;
+    }
+
+    udp.beginPacket(udp.remoteIP(), udp.remotePort());
+    udp.write(packet, responseLength);
+    udp.endPacket();
+}
+
+bool MDNSResponder::begin(const char* hostName) {
+    return hostName && *hostName;
+}
+
+bool MDNSResponder::addService(const char* service, const char* proto, uint16_t port) {
+    (void)service;
+    (void)proto;
+    (void)port;
+    return true;
+}
+
+// ===== WEB SERVER =====
+
+class WebServer::FunctionHandler : public RequestHandler {
+public:
+    FunctionHandler(const String& uri, HTTPMethod method, THandlerFunction fn)
+        : uri(uri), method(method), fn(fn) {}
+
+    bool canHandle(HTTPMethod requestMethod, String requestUri) override {
+        return (method == HTTP_ANY || method == requestMethod) && requestUri == uri;
+    }
+
+    bool handle(WebServer& server, HTTPMethod requestMethod, String requestUri) override {
+        (void)server;
+        if (!canHandle(requestMethod, requestUri)) return false;
+        fn();
+        return true;
+    }
+
+private:
+    String uri;
+    HTTPMethod method;
+    THandlerFunction fn;
+};
+
+WebServer::WebServer(int port) {
+    this->port = (uint16_t)port;
+    listenFd = -1;
+    clientFd = -1;
+    firstHandler = lastHandler = nullptr;
+    currentMethod = HTTP_GET;
+    argCount = 0;
+    headerCount = 1;
+    currentHeaders = new Argument[1];
+    currentHeaders[0].key = "Authorization";
+    contentLength = CONTENT_LENGTH_NOT_SET;
+    chunked = false;
+    headersSent = false;
+}
+
+WebServer::~WebServer() {
+    close();
+    RequestHandler* handler = firstHandler;
+    while (handler) {
+        RequestHandler* next = handler->next();
+        delete handler;
+        handler = next;
+    }
+    delete[] currentHeaders;
+}
+
+void WebServer::begin() {
+    close();
+    listenFd = hostSocket(SOCK_STREAM, port);
+    if (listenFd >= 0 && listen(listenFd, 16) != 0) {
+        ::close(listenFd);
+        listenFd = -1;
+    }
+}
+
+void WebServer::begin(uint16_t port) {
+    this->port = port;
+    begin();
+}
+
+void WebServer::close() {
+    closeClient();
+    if (listenFd >= 0) ::close(listenFd);
+    listenFd = -1;
+}
+
+void WebServer::on(const String& uri, THandlerFunction fn) {
+    on(uri, HTTP_ANY, fn);
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction fn) {
+    addHandler(new FunctionHandler(uri, method, fn));
+}
+
+void WebServer::addHandler(RequestHandler* handler) {
+    if (!lastHandler) {
+        firstHandler = lastHandler = handler;
+    } else {
+        lastHandler->next(handler);
+        lastHandler = handler;
+    }
+}
+
+void WebServer::handleClient() {
+    if (listenFd < 0) return;
+    clientFd = accept(listenFd, nullptr, nullptr);
+    if (clientFd < 0) {
+        // The ESP32 core does delay(1) when nobody is waiting. Same cost for an idle
+        // loop(), but a connection arriving meanwhile ends the wait, so round-trip
+        // measurements aren't padded by up to a millisecond.
+        struct pollfd pfd = { listenFd, POLLIN, 0 };
+        poll(&pfd, 1, 1);
+        return;
+    }
+
+    // The listening socket is non-blocking, the client socket waits with timeouts
+    fcntl(clientFd, F_SETFL, fcntl(clientFd, F_GETFL, 0) & ~O_NONBLOCK);
+    struct timeval rcv = { HTTP_MAX_DATA_WAIT / 1000, (HTTP_MAX_DATA_WAIT % 1000) * 1000 };
+    struct timeval snd = { HTTP_MAX_SEND_WAIT / 1000, (HTTP_MAX_SEND_WAIT % 1000) * 1000 };
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &rcv, sizeof(rcv));
+    setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &snd, sizeof(snd));
+    int one = 1;
+    setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    responseHeaders = String();
+    contentLength = CONTENT_LENGTH_NOT_SET;
+    chunked = false;
+    headersSent = false;
+
+    if (readRequest()) {
+        handleRequest();
+        finalizeResponse();
+    } else {
+        send(400, "text/plain", "Bad Request");
+    }
+    closeClient();
+}
+
+void WebServer::closeClient() {
+    if (clientFd >= 0) {
+        shutdown(clientFd, SHUT_WR);
+        ::close(clientFd);
+    }
+    clientFd = -1;
+}
+
+static bool hostMethod(const char* text, size_t length, HTTPMethod& method) {
+    static const struct { const char* name; HTTPMethod method; } methods[] = {
+        { "GET", HTTP_GET }, { "POST", HTTP_POST }, { "PUT", HTTP_PUT }, { "DELETE", HTTP_DELETE },
+        { "PATCH", HTTP_PATCH }, { "HEAD", HTTP_HEAD }, { "OPTIONS", HTTP_OPTIONS }
+    };
+    for (const auto& m : methods) {
+        if (strlen(m.name) == length && memcmp(m.name, text, length) == 0) {
+            method = m.method;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WebServer::readRequest() {
+    char head[WEBCONFIG_HOST_HTTP_HEAD_SIZE];
+    size_t used = 0;
+    char* headEnd = nullptr;
+    while (!headEnd) {
+        if (used == sizeof(head) - 1) return false;
+        ssize_t n = recv(clientFd, head + used, sizeof(head) - 1 - used, 0);
+        if (n <= 0) return false;
+        used += n;
+        head[used] = '\0';
+        headEnd = strstr(head, "\r\n\r\n");
+    }
+    size_t headLength = headEnd - head + 4;
+
+    // Request line: METHOD URI VERSION
+    char* lineEnd = strstr(head, "\r\n");
+    char* space1 = (char*)memchr(head, ' ', lineEnd - head);
+    char* space2 = space1 ? (char*)memchr(space1 + 1, ' ', lineEnd - space1 - 1) : nullptr;
+    if (!space2 || !hostMethod(head, space1 - head, currentMethod)) return false;
+
+    char* target = space1 + 1;
+    size_t targetLength = space2 - target;
+    char* query = (char*)memchr(target, '?', targetLength);
+    currentUri = String(target, (unsigned int)((query ? query : space2) - target));
+
+    argCount = 0;
+    for (int i = 0; i < headerCount; i++) currentHeaders[i].value = String();
+    hostHeaderValue = String();
+
+    size_t bodyLength = 0;
+    bool formBody = false;
+    char* line = lineEnd + 2;
+    while (line < headEnd) {
+        char* end = strstr(line, "\r\n");
+        char* colon = (char*)memchr(line, ':', end - line);
+        if (colon) {
+            char* value = colon + 1;
+            while (value < end && *value == ' ') value++;
+            size_t nameLength = colon - line;
+            size_t valueLength = end - value;
+            if (nameLength == 14 && strncasecmp(line, "Content-Length", 14) == 0) {
+                bodyLength = strtoul(value, nullptr, 10);
+            } else if (nameLength == 12 && strncasecmp(line, "Content-Type", 12) == 0) {
+                formBody = strncasecmp(value, "application/x-www-form-urlencoded", 33) == 0;
+            } else if (nameLength == 4 && strncasecmp(line, "Host", 4) == 0) {
+                hostHeaderValue = String(value, (unsigned int)valueLength);
+            }
+            storeHeader(line, nameLength, value, valueLength);
+        }
+        line = end + 2;
+    }
+
+    if (query) parseArguments(query + 1, space2 - query - 1);
+    if (bodyLength > WEBCONFIG_HOST_HTTP_BODY_SIZE) return false;
+
+    if (bodyLength) {
+        char* body = (char*)malloc(bodyLength + 1);
+        if (!body) return false;
+        size_t have = std::min(used - headLength, bodyLength);
+        memcpy(body, head + headLength, have);
+        while (have < bodyLength) {
+            ssize_t n = recv(clientFd, body + have, bodyLength - have, 0);
+            if (n <= 0) {
+                free(body);
+                return false;
+            }
+            have += n;
+        }
+        body[bodyLength] = '\0';
+        // Form posts become arguments; any other body is the "plain" argument,
+        // multipart bodies included
+        if (formBody) {
+            parseArguments(body, bodyLength);
+        } else if (argCount < WEBSERVER_MAX_POST_ARGS) {
+            currentArgs[argCount].key = "plain";
+            currentArgs[argCount].value = String(body, (unsigned int)bodyLength);
+            argCount++;
+        }
+        free(body);
+    }
+    return true;
+}
+
+void WebServer::parseArguments(const char* data, size_t length) {
+    const char* end = data + length;
+    while (data < end && argCount < WEBSERVER_MAX_POST_ARGS) {
+        const char* amp = (const char*)memchr(data, '&', end - data);
+        const char* pairEnd = amp ? amp : end;
+        const char* equals = (const char*)memchr(data, '=', pairEnd - data);
+        if (pairEnd > data) {
+            const char* keyEnd = equals ? equals : pairEnd;
+            currentArgs[argCount].key = urlDecode(String(data, (unsigned int)(keyEnd - data)));
+            currentArgs[argCount].value = equals ? urlDecode(String(equals + 1, (unsigned int)(pairEnd - equals - 1)))
+                                                 : String();
+            argCount++;
+        }
+        data = pairEnd + 1;
+    }
+}
+
+void WebServer::storeHeader(const char* name, size_t nameLength, const char* value, size_t valueLength) {
+    for (int i = 0; i < headerCount; i++) {
+        const String& key = currentHeaders[i].key;
+        if (key.length() == nameLength && strncasecmp(key.c_str(), name, nameLength) == 0) {
+            currentHeaders[i].value = String(value, (unsigned int)valueLength);
+            return;
+        }
+    }
+}
+
+void WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    delete[] currentHeaders;
+    headerCount = (int)headerKeysCount + 1;
+    currentHeaders = new Argument[headerCount];
+    currentHeaders[0].key = "Authorization";
+    for (size_t i = 0; i < headerKeysCount; i++) currentHeaders[i + 1].key = headerKeys[i];
+}
+
+String WebServer::header(const String& name) const {
+    for (int i = 0; i < headerCount; i++) {
+        if (currentHeaders[i].key.equalsIgnoreCase(name)) return currentHeaders[i].value;
+    }
+    return String();
+}
+
+String WebServer::header(int i) const {
+    return i >= 0 && i < headerCount ? currentHeaders[i].value : String();
+}
+
+String WebServer::headerName(int i) const {
+    return i >= 0 && i < headerCount ? currentHeaders[i].key : String();
+}
+
+bool WebServer::hasHeader(const String& name) const {
+    for (int i = 0; i < headerCount; i++) {
+        if (currentHeaders[i].key.equalsIgnoreCase(name) && currentHeaders[i].value.length()) return true;
+    }
+    return false;
+}
+
+String WebServer::arg(const String& name) const {
+    for (int i = 0; i < argCount; i++) {
+        if (currentArgs[i].key == name) return currentArgs[i].value;
+    }
+    return String();
+}
+
+String WebServer::arg(int i) const {
+    return i >= 0 && i < argCount ? currentArgs[i].value : String();
+}
+
+String WebServer::argName(int i) const {
+    return i >= 0 && i < argCount ? currentArgs[i].key : String();
+}
+
+bool WebServer::hasArg(const String& name) const {
+    for (int i = 0; i < argCount; i++) {
+        if (currentArgs[i].key == name) return true;
+    }
+    return false;
+}
+
+static size_t hostBase64Encode(const char* data, size_t length, char* out) {
+    static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t bits = (uint8_t)data[i] << 16;
+        if (i + 1 < length) bits |= (uint8_t)data[i + 1] << 8;
+        if (i + 2 < length) bits |= (uint8_t)data[i + 2];
+        out[o++] = ALPHABET[(bits >> 18) & 63];
+        out[o++] = ALPHABET[(bits >> 12) & 63];
+        out[o++] = i + 1 < length ? ALPHABET[(bits >> 6) & 63] : '=';
+        out[o++] = i + 2 < length ? ALPHABET[bits & 63] : '=';
+    }
+    out[o] = '\0';
+    return o;
+}
+
+// Same steps and allocations as the core: copy of the header, substring,
+// then the expected credentials encoded and compared in constant time
+bool WebServer::authenticate(const char* username, const char* password) {
+    if (!hasHeader("Authorization")) return false;
+    String authReq = header("Authorization");
+    if (!authReq.startsWith("Basic")) return false;
+    authReq = authReq.substring(6);
+    authReq.trim();
+
+    size_t toencodeLen = strlen(username) + strlen(password) + 1;
+    char* toencode = new char[toencodeLen + 1];
+    char* encoded = new char[(toencodeLen + 2) / 3 * 4 + 1];
+    sprintf(toencode, "%s:%s", username, password);
+    bool match = hostBase64Encode(toencode, toencodeLen, encoded) > 0 && authReq.equalsConstantTime(encoded);
+    delete[] toencode;
+    delete[] encoded;
+    return match;
+}
+
+void WebServer::requestAuthentication(HTTPAuthMethod mode, const char* realm, const String& authFailMsg) {
+    (void)mode;
+    String value = "Basic realm=\"";
+    value += realm ? realm : "Login Required";
+    value += "\"";
+    sendHeader("WWW-Authenticate", value);
+    send(401, "text/html", authFailMsg);
+}
+
+String WebServer::urlDecode(const String& text) {
+    String decoded;
+    decoded.reserve(text.length());
+    const char* p = text.c_str();
+    while (*p) {
+        if (*p == '+') {
+            decoded += ' ';
+            p++;
+        } else if (*p == '%' && isxdigit((unsigned char)p[1]) && isxdigit((unsigned char)p[2])) {
+            char hex[3] = { p[1], p[2], '\0' };
+            decoded += (char)strtol(hex, nullptr, 16);
+            p += 3;
+        } else {
+            decoded += *p++;
+        }
+    }
+    return decoded;
+}
+
+void WebServer::handleRequest() {
+    bool handled = false;
+    for (RequestHandler* handler = firstHandler; handler; handler = handler->next()) {
+        if (handler->canHandle(currentMethod, currentUri) && handler->handle(*this, currentMethod, currentUri)) {
+            handled = true;
+            break;
+        }
+    }
+    if (!handled) {
+        if (notFoundHandler) {
+            notFoundHandler();
+        } else {
+            send(404, "text/plain", String("Not found: ") + currentUri);
+        }
+    }
+}
+
+void WebServer::finalizeResponse() {
+    if (chunked) writeAll("0\r\n\r\n", 5);
+    chunked = false;
+}
+
+const char* WebServer::responseCodeText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
+
+void WebServer::prepareHeader(String& response, int code, const char* contentType, size_t length) {
+    char line[64];
+    snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n", code, responseCodeText(code));
+    response = line;
+    if (!contentType) contentType = "text/html";
+    response += "Content-Type: ";
+    response += contentType;
+    response += "\r\n";
+    if (contentLength == CONTENT_LENGTH_NOT_SET) contentLength = length;
+    if (contentLength == CONTENT_LENGTH_UNKNOWN) {
+        response += "Transfer-Encoding: chunked\r\n";
+        chunked = true;
+    } else {
+        snprintf(line, sizeof(line), "Content-Length: %lu\r\n", (unsigned long)contentLength);
+        response += line;
+    }
+    response += "Connection: close\r\n";
+    response += responseHeaders;
+    response += "\r\n";
+    responseHeaders = String();
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    if (headersSent || clientFd < 0) return;
+    String head;
+    prepareHeader(head, code, contentType, content.length());
+    headersSent = true;
+    writeAll(head.c_str(), head.length());
+    if (content.length()) sendContent(content);
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content) {
+    send_P(code, contentType, content, content ? strlen(content) : 0);
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+    if (headersSent || clientFd < 0) return;
+    String head;
+    prepareHeader(head, code, contentType, contentLength);
+    headersSent = true;
+    writeAll(head.c_str(), head.length());
+    if (contentLength) sendContent(content, contentLength);
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    String line = name;
+    line += ": ";
+    line += value;
+    line += "\r\n";
+    if (first) {
+        line += responseHeaders;
+        responseHeaders = static_cast<String&&>(line);
+    } else {
+        responseHeaders += line;
+    }
+}
+
+void WebServer::sendContent(const char* content, size_t contentLength) {
+    if (clientFd < 0) return;
+    if (chunked) {
+        // An empty chunk would end the body early
+        if (!contentLength) return;
+        char size[16];
+        int n = snprintf(size, sizeof(size), "%lx\r\n", (unsigned long)contentLength);
+        writeAll(size, n);
+        writeAll(content, contentLength);
+        writeAll("\r\n", 2);
+    } else {
+        writeAll(content, contentLength);
+    }
+}
+
+bool WebServer::writeAll(const char* data, size_t length) {
+    while (length) {
+        ssize_t n = ::send(clientFd, data, length, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            closeClient();
+            return false;
+        }
+        data += n;
+        length -= n;
+    }
+    return true;
+}
+
+// ===== EEPROM =====
+
+static const char* hostEepromPath() {
+    const char* path = getenv("WEBCONFIG_HOST_EEPROM");
+    return path && *path ? path : "eeprom.bin";
+}
+
+EEPROMClass::EEPROMClass() {
+    data = nullptr;
+    size = 0;
+    dirty = false;
+}
+
+EEPROMClass::~EEPROMClass() {
+    end();
+}
+
+bool EEPROMClass::begin(size_t size) {
+    if (size == 0) return false;
+    if (data && this->size == size) return true;
+    end();
+
+    data = (uint8_t*)malloc(size);
+    if (!data) return false;
+    memset(data, 0xFF, size);
+    this->size = size;
+    dirty = false;
+
+    FILE* f = fopen(hostEepromPath(), "rb");
+    if (f) {
+        size_t n = fread(data, 1, size, f);
+        (void)n;
+        fclose(f);
+    }
+    return true;
+}
+
+void EEPROMClass::end() {
+    if (!data) return;
+    commit();
+    free(data);
+    data = nullptr;
+    size = 0;
+}
+
+uint8_t EEPROMClass::read(int address) const {
+    if (!data || address < 0 || (size_t)address >= size) return 0;
+    return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (!data || address < 0 || (size_t)address >= size) return;
+    if (data[address] != value) {
+        data[address] = value;
+        dirty = true;
+    }
+}
+
+bool EEPROMClass::commit() {
+    if (!data) return false;
+    if (!dirty) return true;
+
+    // Write a sibling file and rename it over the image, so a killed
+    // process never leaves half a commit behind
+    char temp[512];
+    snprintf(temp, sizeof(temp), "%s.tmp", hostEepromPath());
+    FILE* f = fopen(temp, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, size, f) == size;
+    ok &= fclose(f) == 0;
+    ok = ok && rename(temp, hostEepromPath()) == 0;
+    if (ok) dirty = false;
+    return ok;
+}
@@ -0,0 +1,755 @@
+/*
+ * ESP32WebConfig Library - Host Platform
+ * Arduino stand-ins for building the library as a Linux or macOS process
+ *
+ * Selected by WebConfigPlatform.h when WEBCONFIG_HOST is defined; the root
+ * CMakeLists.txt builds the library, examples and tests this way. Behaviour
+ * follows the ESP32 Arduino core 2.x:
+ *   String      same API and allocation pattern, 10-byte small-string buffer
+ *   WebServer   HTTP/1.1 on a loopback socket, one request per connection
+ *   WiFiUDP     UDP on loopback, used by CaptiveDNS and DNSServer
+ *   EEPROM      RAM image loaded from and committed to a file
+ *   WiFi        state only; softAP() and begin() succeed at once and raise
+ *               the matching events, localIP() is 127.0.0.1
+ *   ESP         heap figures from the C allocator against a fixed heap size
+ *   MDNS        accepts the calls, nothing is announced
+ *
+ * Device ports are moved by WEBCONFIG_HOST_PORT_OFFSET (environment, default
+ * 8000), so WebServer(80) listens on 127.0.0.1:8080 and DNS on 8053. The
+ * EEPROM file is WEBCONFIG_HOST_EEPROM (environment, default eeprom.bin).
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGHOST_H
+#define WEBCONFIGHOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+
+// Heap the ESP figures are reported against, close to an ESP32 with WiFi up
+#ifndef WEBCONFIG_HOST_HEAP_SIZE
+#define WEBCONFIG_HOST_HEAP_SIZE 327680
+#endif
+
+#define WEBCONFIG_HOST_PORT_OFFSET 8000
+
+// ===== ARDUINO CORE =====
+
+#define PROGMEM
+#define IRAM_ATTR
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+#define F(s) FPSTR(PSTR(s))
+
+template <typename T> inline T webConfigHostRead(const void* addr) {
+    T value;
+    memcpy(&value, addr, sizeof(value));
+    return value;
+}
+#define pgm_read_byte(addr) webConfigHostRead<uint8_t>(addr)
+#define pgm_read_word(addr) webConfigHostRead<uint16_t>(addr)
+#define pgm_read_dword(addr) webConfigHostRead<uint32_t>(addr)
+#define pgm_read_float(addr) webConfigHostRead<float>(addr)
+#define pgm_read_ptr(addr) webConfigHostRead<void*>(addr)
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strstr_P strstr
+#define memcpy_P memcpy
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define LED_BUILTIN 2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// ===== STRING =====
+
+class StringSumHelper;
+
+class String {
+public:
+    String(const char* cstr = "");
+    String(const char* cstr, unsigned int length);
+    String(const String& str);
+    String(const __FlashStringHelper* str);
+    String(String&& rval);
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+    ~String();
+
+    // False when out of memory; the string is then left unchanged
+    bool reserve(unsigned int size);
+    unsigned int length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    void clear();
+
+    String& operator=(const String& rhs);
+    String& operator=(const char* cstr);
+    String& operator=(const __FlashStringHelper* str);
+    String& operator=(String&& rval);
+
+    bool concat(const String& str);
+    bool concat(const char* cstr);
+    bool concat(const char* cstr, unsigned int length);
+    bool concat(const __FlashStringHelper* str);
+    bool concat(char c);
+    bool concat(unsigned char num);
+    bool concat(int num);
+    bool concat(unsigned int num);
+    bool concat(long num);
+    bool concat(unsigned long num);
+    bool concat(long long num);
+    bool concat(unsigned long long num);
+    bool concat(float num);
+    bool concat(double num);
+
+    template <typename T> String& operator+=(const T& rhs) { concat(rhs); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, const __FlashStringHelper* rhs);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, char c);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned char num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, int num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned int num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, long num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned long num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, long long num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, unsigned long long num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, float num);
+    friend StringSumHelper& operator+(const StringSumHelper& lhs, double num);
+
+    int compareTo(const String& s) const;
+    bool equals(const String& s) const;
+    bool equals(const char* cstr) const;
+    bool equalsIgnoreCase(const String& s) const;
+    bool equalsConstantTime(const String& s) const;
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+    bool operator<(const String& rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String& rhs) const { return compareTo(rhs) > 0; }
+    bool operator<=(const String& rhs) const { return compareTo(rhs) <= 0; }
+    bool operator>=(const String& rhs) const { return compareTo(rhs) >= 0; }
+    bool startsWith(const String& prefix) const;
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    char charAt(unsigned int index) const;
+    void setCharAt(unsigned int index, char c);
+    char operator[](unsigned int index) const;
+    char& operator[](unsigned int index);
+    void getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0) const;
+    void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const {
+        getBytes((unsigned char*)buf, bufsize, index);
+    }
+    const char* c_str() const { return buffer(); }
+    char* begin() { return wbuffer(); }
+    char* end() { return wbuffer() + len; }
+    const char* begin() const { return c_str(); }
+    const char* end() const { return c_str() + len; }
+
+    int indexOf(char ch) const;
+    int indexOf(char ch, unsigned int fromIndex) const;
+    int indexOf(const String& str) const;
+    int indexOf(const String& str, unsigned int fromIndex) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(char ch, unsigned int fromIndex) const;
+    int lastIndexOf(const String& str) const;
+    int lastIndexOf(const String& str, unsigned int fromIndex) const;
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, len); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+private:
+    // Strings up to SSO_SIZE - 1 characters live in sso, longer ones on the heap
+    enum { SSO_SIZE = 11 };
+
+    char* ptr;              // Heap buffer, nullptr while the string fits in sso
+    unsigned int len;
+    unsigned int capacity;  // Characters the buffer holds, without the terminator
+    char sso[SSO_SIZE];
+
+    const char* buffer() const { return ptr ? ptr : sso; }
+    char* wbuffer() { return ptr ? ptr : sso; }
+    void init();
+    bool changeBuffer(unsigned int maxStrLen);
+    String& copy(const char* cstr, unsigned int length);
+    void move(String& rhs);
+    bool concatNumber(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void setNumber(unsigned long long value, unsigned char base, bool negative);
+};
+
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& s) : String(s) {}
+    StringSumHelper(const char* p) : String(p) {}
+    StringSumHelper(char c) : String(c) {}
+    StringSumHelper(unsigned char num) : String(num) {}
+    StringSumHelper(int num) : String(num) {}
+    StringSumHelper(unsigned int num) : String(num) {}
+    StringSumHelper(long num) : String(num) {}
+    StringSumHelper(unsigned long num) : String(num) {}
+    StringSumHelper(long long num) : String(num) {}
+    StringSumHelper(unsigned long long num) : String(num) {}
+    StringSumHelper(float num) : String(num) {}
+    StringSumHelper(double num) : String(num) {}
+};
+
+// ===== SERIAL =====
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const __FlashStringHelper* str) { return write((const char*)str); }
+    size_t print(const String& str) { return write(str.c_str(), str.length()); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char num, int base = DEC) { return print((unsigned long long)num, base); }
+    size_t print(int num, int base = DEC) { return print((long long)num, base); }
+    size_t print(unsigned int num, int base = DEC) { return print((unsigned long long)num, base); }
+    size_t print(long num, int base = DEC) { return print((long long)num, base); }
+    size_t print(unsigned long num, int base = DEC) { return print((unsigned long long)num, base); }
+    size_t print(long long num, int base = DEC);
+    size_t print(unsigned long long num, int base = DEC);
+    size_t print(double num, int digits = 2);
+
+    template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+    size_t println(const char* str) { size_t n = print(str); return n + println(); }
+    size_t println() { return write("\r\n"); }
+};
+
+// Writes to stdout; nothing is ever received
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() { flush(); }
+    void flush();
+    void setDebugOutput(bool enable) { (void)enable; }
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    operator bool() const { return true; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// ===== ESP =====
+
+class EspClass {
+public:
+    uint32_t getHeapSize() { return WEBCONFIG_HOST_HEAP_SIZE; }
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    // No fragmentation model, the whole free heap counts as one block
+    uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+    uint32_t getPsramSize() { return 0; }
+    uint32_t getFreePsram() { return 0; }
+
+    uint32_t getCpuFreqMHz();
+    uint32_t getCycleCount();
+    const char* getChipModel() { return "host"; }
+    uint8_t getChipRevision() { return 0; }
+    const char* getSdkVersion() { return "host"; }
+    uint32_t getFlashChipSize() { return 0; }
+    uint32_t getSketchSize() { return 0; }
+    uint32_t getFreeSketchSpace() { return 0; }
+    uint64_t getEfuseMac() { return 0; }
+
+    // Fills resultArray from the system random source, as on ESP8266
+    uint8_t* random(uint8_t* resultArray, size_t outputSizeBytes);
+
+    // Starts the process again with the same arguments; EEPROM stays in its file
+    void restart();
+};
+
+extern EspClass ESP;
+
+// ===== NETWORK =====
+
+class IPAddress {
+public:
+    IPAddress() { memset(bytes, 0, sizeof(bytes)); }
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) {
+        bytes[0] = first; bytes[1] = second; bytes[2] = third; bytes[3] = fourth;
+    }
+    IPAddress(uint32_t address) { memcpy(bytes, &address, sizeof(bytes)); }
+
+    bool fromString(const char* address);
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+    String toString() const;
+
+    operator uint32_t() const { uint32_t a; memcpy(&a, bytes, sizeof(a)); return a; }
+    bool operator==(const IPAddress& other) const { return memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t& operator[](int index) { return bytes[index]; }
+
+private:
+    uint8_t bytes[4];
+};
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+    WIFI_MODE_AP,
+    WIFI_MODE_APSTA,
+    WIFI_MODE_MAX
+} wifi_mode_t;
+
+#define WIFI_OFF WIFI_MODE_NULL
+#define WIFI_STA WIFI_MODE_STA
+#define WIFI_AP WIFI_MODE_AP
+#define WIFI_AP_STA WIFI_MODE_APSTA
+
+// Event ids in the order of the ESP32 core
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_SCAN_DONE,
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_STOP,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+    ARDUINO_EVENT_WIFI_AP_START,
+    ARDUINO_EVENT_WIFI_AP_STOP,
+    ARDUINO_EVENT_WIFI_AP_STACONNECTED,
+    ARDUINO_EVENT_WIFI_AP_STADISCONNECTED,
+    ARDUINO_EVENT_WIFI_AP_STAIPASSIGNED,
+    ARDUINO_EVENT_WIFI_AP_PROBEREQRECVED,
+    ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+
+typedef union {
+    uint8_t raw[32];
+} arduino_event_info_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef size_t wifi_event_id_t;
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+
+#define WEBCONFIG_HOST_WIFI_EVENTS 8
+
+// Handlers run synchronously inside the call that raised the event, not
+// from a separate task as on the device
+class WiFiClass {
+public:
+    WiFiClass();
+
+    bool mode(wifi_mode_t mode);
+    wifi_mode_t getMode() const { return currentMode; }
+
+    bool softAPConfig(IPAddress localIP, IPAddress gateway, IPAddress subnet);
+    bool softAP(const char* ssid, const char* passphrase = nullptr, int channel = 1, int hidden = 0, int maxConnection = 4);
+    bool softAPdisconnect(bool wifioff = false);
+    IPAddress softAPIP() const { return apIP; }
+    String softAPSSID() const { return apSSID; }
+    uint8_t softAPgetStationNum() const { return stations; }
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet);
+    bool disconnect(bool wifioff = false);
+    wl_status_t status() const { return staStatus; }
+    bool isConnected() const { return staStatus == WL_CONNECTED; }
+    IPAddress localIP() const;
+    String SSID() const { return staSSID; }
+    int8_t RSSI() const { return staStatus == WL_CONNECTED ? -50 : 0; }
+    String macAddress() const { return String("02:00:00:00:00:01"); }
+
+    // event ARDUINO_EVENT_MAX subscribes to all events; 0 means no free slot
+    wifi_event_id_t onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+    void removeEvent(wifi_event_id_t id);
+
+    // Host only: pretend count stations are associated with the softAP
+    void setStationCount(uint8_t count);
+
+private:
+    struct Handler {
+        WiFiEventFuncCb callback;
+        arduino_event_id_t event;
+        wifi_event_id_t id;
+    };
+
+    Handler handlers[WEBCONFIG_HOST_WIFI_EVENTS];
+    wifi_event_id_t nextEventId;
+    wifi_mode_t currentMode;
+    wl_status_t staStatus;
+    IPAddress apIP;
+    IPAddress staIP;
+    String apSSID;
+    String staSSID;
+    uint8_t stations;
+
+    void raise(arduino_event_id_t event);
+};
+
+extern WiFiClass WiFi;
+
+class WiFiUDP {
+public:
+    WiFiUDP();
+    ~WiFiUDP();
+
+    // Binds 127.0.0.1:port + WEBCONFIG_HOST_PORT_OFFSET; 1 on success
+    uint8_t begin(uint16_t port);
+    void stop();
+
+    // Size of the next datagram, 0 when none is waiting
+    int parsePacket();
+    int available() const { return (int)(rxLength - rxPos); }
+    int read();
+    int read(uint8_t* buffer, size_t len);
+    int read(char* buffer, size_t len) { return read((uint8_t*)buffer, len); }
+    void flush() { rxPos = rxLength; }
+    IPAddress remoteIP() const { return remoteAddress; }
+    uint16_t remotePort() const { return remotePortNumber; }
+
+    int beginPacket(IPAddress ip, uint16_t port);
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size);
+    int endPacket();
+
+private:
+    enum { MAX_PACKET = 1472 };
+
+    int fd;
+    uint8_t rx[MAX_PACKET];
+    size_t rxLength;
+    size_t rxPos;
+    uint8_t tx[MAX_PACKET];
+    size_t txLength;
+    IPAddress remoteAddress;
+    uint16_t remotePortNumber;
+    IPAddress txAddress;
+    uint16_t txPort;
+};
+
+enum class DNSReplyCode {
+    NoError = 0,
+    FormError = 1,
+    ServerFailure = 2,
+    NonExistentDomain = 3,
+    NotImplemented = 4,
+    Refused = 5
+};
+
+// Answers A queries for one domain ("*" for all) with a fixed address
+class DNSServer {
+public:
+    DNSServer();
+
+    bool start(const uint16_t& port, const String& domainName, const IPAddress& resolvedIP);
+    void stop();
+    void processNextRequest();
+    void setErrorReplyCode(const DNSReplyCode& replyCode) { errorReplyCode = replyCode; }
+    void setTTL(const uint32_t& ttl) { this->ttl = ttl; }
+
+private:
+    WiFiUDP udp;
+    String domainName;
+    IPAddress resolvedIP;
+    DNSReplyCode errorReplyCode;
+    uint32_t ttl;
+    uint8_t packet[512];
+
+    bool matchesDomain(size_t length) const;
+};
+
+class MDNSResponder {
+public:
+    bool begin(const char* hostName);
+    void end() {}
+    bool addService(const char* service, const char* proto, uint16_t port);
+};
+
+extern MDNSResponder MDNS;
+
+// ===== WEB SERVER =====
+
+typedef enum {
+    HTTP_DELETE = 0,
+    HTTP_GET = 1,
+    HTTP_HEAD = 2,
+    HTTP_POST = 3,
+    HTTP_PUT = 4,
+    HTTP_OPTIONS = 6,
+    HTTP_PATCH = 28
+} HTTPMethod;
+
+#define HTTP_ANY ((HTTPMethod)255)
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+#define HTTP_MAX_DATA_WAIT 5000     // ms to wait for the request
+#define HTTP_MAX_SEND_WAIT 5000     // ms to wait for the client to take data
+#define WEBSERVER_MAX_POST_ARGS 32
+#define WEBCONFIG_HOST_HTTP_HEAD_SIZE 4096
+#define WEBCONFIG_HOST_HTTP_BODY_SIZE 65536
+
+enum HTTPAuthMethod { BASIC_AUTH, DIGEST_AUTH };
+
+class WebServer;
+
+class RequestHandler {
+public:
+    virtual ~RequestHandler() {}
+    virtual bool canHandle(HTTPMethod method, String uri) { (void)method; (void)uri; return false; }
+    virtual bool canUpload(String uri) { (void)uri; return false; }
+    virtual bool handle(WebServer& server, HTTPMethod requestMethod, String requestUri) {
+        (void)server; (void)requestMethod; (void)requestUri;
+        return false;
+    }
+
+    RequestHandler* next() { return nextHandler; }
+    void next(RequestHandler* r) { nextHandler = r; }
+
+private:
+    RequestHandler* nextHandler = nullptr;
+};
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80);
+    ~WebServer();
+
+    // Listens on 127.0.0.1:port + WEBCONFIG_HOST_PORT_OFFSET
+    void begin();
+    void begin(uint16_t port);
+    void stop() { close(); }
+    void close();
+
+    // Serves at most one waiting connection; waits up to 1 ms for one when none is
+    void handleClient();
+
+    bool authenticate(const char* username, const char* password);
+    void requestAuthentication(HTTPAuthMethod mode = BASIC_AUTH, const char* realm = nullptr,
+                               const String& authFailMsg = String(""));
+
+    void on(const String& uri, THandlerFunction fn);
+    void on(const String& uri, HTTPMethod method, THandlerFunction fn);
+    void addHandler(RequestHandler* handler);
+    void onNotFound(THandlerFunction fn) { notFoundHandler = fn; }
+
+    String uri() const { return currentUri; }
+    HTTPMethod method() const { return currentMethod; }
+
+    String arg(const String& name) const;
+    String arg(int i) const;
+    String argName(int i) const;
+    int args() const { return argCount; }
+    bool hasArg(const String& name) const;
+
+    // Only collected headers and Authorization are kept
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const String& name) const;
+    String header(int i) const;
+    String headerName(int i) const;
+    int headers() const { return headerCount; }
+    bool hasHeader(const String& name) const;
+    String hostHeader() const { return hostHeaderValue; }
+
+    void send(int code, const char* contentType = nullptr, const String& content = String(""));
+    void send(int code, char* contentType, const String& content) { send(code, (const char*)contentType, content); }
+    void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+    void send_P(int code, PGM_P contentType, PGM_P content);
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+
+    void setContentLength(const size_t contentLength) { this->contentLength = contentLength; }
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t contentLength);
+    void sendContent_P(PGM_P content) { sendContent(content, strlen(content)); }
+    void sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+
+    static String urlDecode(const String& text);
+
+private:
+    struct Argument {
+        String key;
+        String value;
+    };
+
+    class FunctionHandler;
+
+    uint16_t port;
+    int listenFd;
+    int clientFd;
+
+    RequestHandler* firstHandler;
+    RequestHandler* lastHandler;
+    THandlerFunction notFoundHandler;
+
+    HTTPMethod currentMethod;
+    String currentUri;
+    Argument currentArgs[WEBSERVER_MAX_POST_ARGS];
+    int argCount;
+    Argument* currentHeaders;
+    int headerCount;
+    String hostHeaderValue;
+
+    String responseHeaders;
+    size_t contentLength;
+    bool chunked;
+    bool headersSent;
+
+    bool readRequest();
+    void parseArguments(const char* data, size_t length);
+    void storeHeader(const char* name, size_t nameLength, const char* value, size_t valueLength);
+    void handleRequest();
+    void finalizeResponse();
+    void prepareHeader(String& response, int code, const char* contentType, size_t length);
+    bool writeAll(const char* data, size_t length);
+    void closeClient();
+    static const char* responseCodeText(int code);
+};
+
+// ===== EEPROM =====
+
+class EEPROMClass {
+public:
+    EEPROMClass();
+    ~EEPROMClass();
+
+    // Loads the first size bytes of the EEPROM file, 0xFF past its end
+    bool begin(size_t size);
+    void end();
+
+    uint8_t read(int address) const;
+    void write(int address, uint8_t value);
+    // Writes the image to the file when it changed since begin() or the last commit
+    bool commit();
+
+    uint8_t* getDataPtr() { dirty = true; return data; }
+    const uint8_t* getConstDataPtr() const { return data; }
+    uint16_t length() const { return (uint16_t)size; }
+
+    template <typename T> T& get(int address, T& t) const {
+        if (address < 0 || (size_t)address + sizeof(T) > size) return t;
+        memcpy((uint8_t*)&t, data + address, sizeof(T));
+        return t;
+    }
+
+    template <typename T> const T& put(int address, const T& t) {
+        if (address < 0 || (size_t)address + sizeof(T) > size) return t;
+        if (memcmp(data + address, (const uint8_t*)&t, sizeof(T)) != 0) {
+            memcpy(data + address, (const uint8_t*)&t, sizeof(T));
+            dirty = true;
+        }
+        return t;
+    }
+
+private:
+    uint8_t* data;
+    size_t size;
+    bool dirty;
+};
+
+extern EEPROMClass EEPROM;
+
+// ===== HOST CONTROL =====
+
+// Call first in main(): keeps argv for ESP.restart() and turns SIGINT and
+// SIGTERM into webConfigHostStopped()
+void webConfigHostBegin(int argc, char** argv);
+bool webConfigHostStopped();
+
+// Loopback port a device port is served on
+uint16_t webConfigHostPort(uint16_t devicePort);
+
+#endif // WEBCONFIGHOST_H
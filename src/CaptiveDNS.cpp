@@ -0,0 +1,169 @@
+/*
+ * ESP32WebConfig Library - Captive Portal DNS Responder Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigFeatures.h"
+
+#if WEBCONFIG_ENABLE_CAPTIVE_DNS
+
+#include "CaptiveDNS.h"
+
+// DNS header offsets and constants
+#define DNS_HEADER_SIZE 12
+#define DNS_QR_FLAG 0x80
+#define DNS_OPCODE_MASK 0x78
+#define DNS_AA_FLAG 0x04
+#define DNS_RD_FLAG 0x01
+#define DNS_TYPE_A 1
+#define DNS_TYPE_ANY 255
+#define DNS_CLASS_IN 1
+
+CaptiveDNS::CaptiveDNS() {
+    port = CAPTIVE_DNS_PORT;
+    running = false;
+    suspended = false;
+    autoSuspend = true;
+    lastStationCheck = 0;
+    memset(answer, 0, sizeof(answer));
+    resetStats();
+}
+
+CaptiveDNS::~CaptiveDNS() {
+    stop();
+}
+
+bool CaptiveDNS::start(const IPAddress& ip, uint16_t dnsPort) {
+    port = dnsPort;
+
+    // Answer record is identical for every query, build it once
+    answer[0] = 0xC0;                    // Name: pointer to question at offset 12
+    answer[1] = DNS_HEADER_SIZE;
+    answer[2] = 0x00;                    // Type A
+    answer[3] = DNS_TYPE_A;
+    answer[4] = 0x00;                    // Class IN
+    answer[5] = DNS_CLASS_IN;
+    answer[6] = (CAPTIVE_DNS_TTL >> 24) & 0xFF;
+    answer[7] = (CAPTIVE_DNS_TTL >> 16) & 0xFF;
+    answer[8] = (CAPTIVE_DNS_TTL >> 8) & 0xFF;
+    answer[9] = CAPTIVE_DNS_TTL & 0xFF;
+    answer[10] = 0x00;                   // RDLENGTH 4
+    answer[11] = 0x04;
+    answer[12] = ip[0];
+    answer[13] = ip[1];
+    answer[14] = ip[2];
+    answer[15] = ip[3];
+
+    running = udp.begin(port) == 1;
+    suspended = false;
+    lastStationCheck = millis();
+    return running;
+}
+
+void CaptiveDNS::stop() {
+    if (running && !suspended) {
+        udp.stop();
+    }
+    running = false;
+    suspended = false;
+}
+
+void CaptiveDNS::setAutoSuspend(bool enable) {
+    autoSuspend = enable;
+    if (!autoSuspend && running && suspended) {
+        suspended = !(udp.begin(port) == 1);
+    }
+}
+
+void CaptiveDNS::resetStats() {
+    queriesAnswered = 0;
+    queriesDropped = 0;
+    timeSpentMicros = 0;
+}
+
+void CaptiveDNS::checkStations() {
+    if (millis() - lastStationCheck < CAPTIVE_DNS_STATION_POLL) return;
+    lastStationCheck = millis();
+
+    bool hasStations = WiFi.softAPgetStationNum() > 0;
+    if (!hasStations && !suspended) {
+        udp.stop();
+        suspended = true;
+    } else if (hasStations && suspended) {
+        suspended = !(udp.begin(port) == 1);
+    }
+}
+
+void CaptiveDNS::processNextRequest() {
+    if (!running) return;
+
+    if (autoSuspend) {
+        checkStations();
+    }
+    if (suspended) return;
+
+    int length = udp.parsePacket();
+    if (length <= 0) return;
+
+    unsigned long start = micros();
+
+    if (length < DNS_HEADER_SIZE || length > (int)sizeof(packet)) {
+        udp.flush();
+        queriesDropped++;
+        timeSpentMicros += micros() - start;
+        return;
+    }
+
+    udp.read(packet, length);
+    size_t responseLength = buildResponse(length);
+    if (responseLength == 0) {
+        queriesDropped++;
+    } else {
+        udp.beginPacket(udp.remoteIP(), udp.remotePort());
+        udp.write(packet, responseLength);
+        udp.endPacket();
+        queriesAnswered++;
+    }
+
+    timeSpentMicros += micros() - start;
+}
+
+size_t CaptiveDNS::buildResponse(size_t length) {
+    // Only standard queries with exactly one question
+    if ((packet[2] & DNS_QR_FLAG) || (packet[2] & DNS_OPCODE_MASK)) return 0;
+    if (packet[4] != 0 || packet[5] != 1) return 0;
+
+    // Skip question name labels
+    size_t pos = DNS_HEADER_SIZE;
+    while (pos < length && packet[pos] != 0) {
+        if (packet[pos] & 0xC0) return 0;   // Compression is not valid in a question
+        pos += packet[pos] + 1;
+    }
+    pos += 1 + 4;                            // Terminator, QTYPE, QCLASS
+    if (pos > length) return 0;
+
+    uint16_t qtype = (packet[pos - 4] << 8) | packet[pos - 3];
+    uint16_t qclass = (packet[pos - 2] << 8) | packet[pos - 1];
+    bool answerable = (qtype == DNS_TYPE_A || qtype == DNS_TYPE_ANY) && qclass == DNS_CLASS_IN;
+
+    // Turn the query into a response in place, dropping any additional records
+    packet[2] = DNS_QR_FLAG | DNS_AA_FLAG | (packet[2] & DNS_RD_FLAG);
+    packet[3] = 0x00;                        // NOERROR
+    packet[6] = 0x00;                        // ANCOUNT
+    packet[7] = answerable ? 1 : 0;
+    packet[8] = packet[9] = 0x00;            // NSCOUNT
+    packet[10] = packet[11] = 0x00;          // ARCOUNT
+
+    if (!answerable) {
+        // Empty answer lets clients give up on AAAA etc. without a retry
+        return pos;
+    }
+
+    if (pos + sizeof(answer) > sizeof(packet)) return 0;
+    memcpy(packet + pos, answer, sizeof(answer));
+    return pos + sizeof(answer);
+}
+
+#endif // WEBCONFIG_ENABLE_CAPTIVE_DNS
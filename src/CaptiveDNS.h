@@ -0,0 +1,60 @@
+/*
+ * ESP32WebConfig Library - Captive Portal DNS Responder
+ * Answers every DNS query with the AP address from a prebuilt template
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef CAPTIVEDNS_H
+#define CAPTIVEDNS_H
+
+#include "WebConfigPlatform.h"
+
+#define CAPTIVE_DNS_PORT 53
+#define CAPTIVE_DNS_MAX_PACKET 512       // Classic DNS over UDP limit
+#define CAPTIVE_DNS_TTL 60               // Seconds clients may cache the answer
+#define CAPTIVE_DNS_STATION_POLL 1000    // ms between softAP station checks
+
+class CaptiveDNS {
+public:
+    CaptiveDNS();
+    ~CaptiveDNS();
+
+    // Start answering all A queries with ip
+    bool start(const IPAddress& ip, uint16_t port = CAPTIVE_DNS_PORT);
+    void stop();
+
+    // Answer at most one pending query, call from loop
+    void processNextRequest();
+
+    // Close the socket while no station is associated with the softAP
+    void setAutoSuspend(bool enable);
+    bool isRunning() const { return running; }
+    bool isSuspended() const { return suspended; }
+
+    // Statistics
+    uint32_t getQueriesAnswered() const { return queriesAnswered; }
+    uint32_t getQueriesDropped() const { return queriesDropped; }
+    uint32_t getTimeSpentMicros() const { return timeSpentMicros; }
+    void resetStats();
+
+private:
+    WiFiUDP udp;
+    uint8_t packet[CAPTIVE_DNS_MAX_PACKET];
+    uint8_t answer[16];                  // Prebuilt answer record (name pointer, A, IN, TTL, IP)
+    uint16_t port;
+    bool running;
+    bool suspended;
+    bool autoSuspend;
+    unsigned long lastStationCheck;
+
+    uint32_t queriesAnswered;
+    uint32_t queriesDropped;
+    uint32_t timeSpentMicros;
+
+    void checkStations();
+    size_t buildResponse(size_t length);
+};
+
+#endif // CAPTIVEDNS_H
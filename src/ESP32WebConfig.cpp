@@ -7,23 +7,74 @@
  */
 
 #include "ESP32WebConfig.h"
+#if WEBCONFIG_ENABLE_PAGES
 #include "WebPages.h"
+#endif
+#include "WebConfigRouter.h"
+
+// Escaped JSON string, for hand-written JSON
+static void appendJsonString(String& out, const String& value) {
+    out += '"';
+    for (size_t i = 0; i < value.length(); i++) {
+        char c = value[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((uint8_t)c < 0x20) {
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (uint8_t)c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+#if WEBCONFIG_ENABLE_JSON
+// Sized once from measureJson(), so the String is not regrown while written
+static String toJsonString(const JsonDocument& doc) {
+    String output;
+    output.reserve(measureJson(doc));
+    serializeJson(doc, output);
+    return output;
+}
+
+// Keys point into the descriptors, no String copy is needed to set them
+#ifdef ESP8266
+#define WC_JSON_KEY(param) FPSTR((param).getKeyData())
+#else
+#define WC_JSON_KEY(param) (param).getKeyData()
+#endif
+#endif
 
 // ===== CONSTRUCTOR AND DESTRUCTOR =====
 
-ESP32WebConfig::ESP32WebConfig() {
+ESP32WebConfig::ESP32WebConfig() : requestArena(WEBCONFIG_REQUEST_ARENA_SIZE) {
     server = nullptr;
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
     dnsServer = nullptr;
+    dnsAutoSuspend = true;
+    captiveProbeCount = 0;
+    #endif
     initialized = false;
     configChanged = false;
+    memset(statusOffsets, 0, sizeof(statusOffsets));
+    statusStale = true;
+    statusConnected = false;
+    #ifndef ESP8266
+    statusEventId = 0;
+    #endif
     lastSave = 0;
     saveDelay = 5000; // 5 seconds delay for auto-save
+    maxRequestsPerLoop = WEBCONFIG_MAX_REQUESTS_PER_LOOP;
+    requestsServed = 0;
+    handleBudgetMicros = WEBCONFIG_HANDLE_BUDGET_US;
     eepromSize = WEBCONFIG_EEPROM_SIZE;
     eepromStartAddr = 0;
     autoSave = true;
     enableSTA = false;
     useDHCP = true;
-    enableMDNS = true;
     
     // Default AP configuration
     apSSID = "ESP32-Config";
@@ -32,29 +83,43 @@ ESP32WebConfig::ESP32WebConfig() {
     apGateway = IPAddress(192, 168, 4, 1);
     apSubnet = IPAddress(255, 255, 255, 0);
     
+    #if WEBCONFIG_ENABLE_AUTH
     // Default admin credentials
     adminUsername = "admin";
     adminPassword = "admin";
+    sessionAuth = false;
+    #endif
     
     // Default device name
     deviceName = "ESP32-Device";
+    #if WEBCONFIG_ENABLE_MDNS
+    enableMDNS = true;
     mdnsName = "esp32-config";
+    #endif
 }
 
 ESP32WebConfig::~ESP32WebConfig() {
+    #ifndef ESP8266
+    if (statusEventId) WiFi.removeEvent(statusEventId);
+    #endif
     if (server) delete server;
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
     if (dnsServer) delete dnsServer;
+    #endif
 }
 
 // ===== BASIC CONFIGURATION =====
 
 void ESP32WebConfig::setDeviceName(const String& name) {
     deviceName = name;
+    statusStale = true;
+    #if WEBCONFIG_ENABLE_MDNS
     if (mdnsName == "esp32-config") {  // If mDNS wasn't changed
         mdnsName = name;
         mdnsName.toLowerCase();
         mdnsName.replace(" ", "-");
     }
+    #endif
 }
 
 void ESP32WebConfig::setAPConfig(const String& ssid, const String& password, IPAddress ip) {
@@ -75,196 +140,355 @@ void ESP32WebConfig::setSTAConfig(const String& ssid, const String& password, IP
     useDHCP = (ip == IPAddress(0, 0, 0, 0));
 }
 
+#if WEBCONFIG_ENABLE_AUTH
 void ESP32WebConfig::setCredentials(const String& username, const String& password) {
     adminUsername = username;
     adminPassword = password;
+    // Cookies issued under the old credentials must not outlive them
+    session.revoke();
 }
 
+void ESP32WebConfig::enableSessionAuth(bool enable, uint32_t timeoutSeconds) {
+    sessionAuth = enable;
+    session.setTimeout(timeoutSeconds);
+}
+
+void ESP32WebConfig::revokeSessions() {
+    session.revoke();
+}
+#endif
+
+#if WEBCONFIG_ENABLE_MDNS
 void ESP32WebConfig::setMDNS(const String& name) {
     mdnsName = name;
     mdnsName.toLowerCase();
     mdnsName.replace(" ", "-");
     enableMDNS = true;
 }
+#endif
 
 void ESP32WebConfig::setEEPROM(int size, int startAddr) {
     eepromSize = size;
     eepromStartAddr = startAddr;
 }
 
+void ESP32WebConfig::setClientServiceBudget(uint8_t maxRequests, uint32_t budgetMicros) {
+    maxRequestsPerLoop = maxRequests > 0 ? maxRequests : 1;
+    handleBudgetMicros = budgetMicros;
+}
+
+#if WEBCONFIG_ENABLE_CAPTIVE_DNS
+void ESP32WebConfig::setCaptiveDNSAutoSuspend(bool enable) {
+    dnsAutoSuspend = enable;
+    if (dnsServer) dnsServer->setAutoSuspend(enable);
+}
+#endif
+
 // ===== PARAMETERS - BASIC ADDITION =====
 
+void ESP32WebConfig::reserveParameters(size_t count) {
+    parameters.reserve(count, true);
+}
+
+bool ESP32WebConfig::compactParameters() {
+    return parameters.compact();
+}
+
+ConfigParameter* ESP32WebConfig::appendParameter(const String& key, const String& label, ParameterType type, const String& defaultValue) {
+    ConfigParameterDescriptor* descriptor = parameters.createDescriptor();
+    if (descriptor) {
+        descriptor->type = type;
+        descriptor->minValue = 0;
+        descriptor->maxValue = 100;
+        descriptor->step = 1;
+        descriptor->group = "general";
+    }
+    ConfigParameter* param = descriptor ? parameters.add(descriptor, WEBCONFIG_PARAM_OWNED) : nullptr;
+    if (!param) {
+        WC_LOGE("ESP32WebConfig: No memory for parameter %s", key.c_str());
+        return nullptr;
+    }
+    parameters.setString(*param, DESC_KEY, key);
+    parameters.setString(*param, DESC_LABEL, label);
+    parameters.setString(*param, DESC_DEFAULT, defaultValue);
+    param->value = defaultValue;
+    param->parseValue();
+    return param;
+}
+
+// Handle to the parameter appendParameter() just added
+template <typename T>
+ParamHandle<T> ESP32WebConfig::handleTo(const ConfigParameter* param) {
+    ParamHandle<T> handle = { (uint16_t)(param ? parameters.size() - 1 : WEBCONFIG_INVALID_HANDLE) };
+    return handle;
+}
+
 void ESP32WebConfig::addParameter(const String& key, const String& label, ParameterType type, const String& defaultValue) {
-    ConfigParameter param;
-    param.key = key;
-    param.label = label;
-    param.type = type;
-    param.value = defaultValue;
-    param.defaultValue = defaultValue;
-    param.required = false;
-    param.readOnly = false;
-    param.order = parameters.size();
-    param.group = "general";
-    param.minValue = 0;
-    param.maxValue = 100;
-    param.step = 1;
-    
-    parameters.push_back(param);
+    appendParameter(key, label, type, defaultValue);
 }
 
 void ESP32WebConfig::addParameter(const String& key, const String& label, ParameterType type,
                                  const String& defaultValue, const String& description,
                                  const String& validation, bool required) {
-    addParameter(key, label, type, defaultValue);
-    
-    // Find just added parameter and modify it
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.description = description;
-            param.validation = validation;
-            param.required = required;
-            break;
-        }
+    ConfigParameter* param = appendParameter(key, label, type, defaultValue);
+    if (!param) return;
+    parameters.setString(*param, DESC_DESCRIPTION, description);
+    parameters.setString(*param, DESC_VALIDATION, validation);
+    parameters.edit(*param)->required = required;
+}
+
+void ESP32WebConfig::addParameter(const ConfigParameterDescriptor& descriptor) {
+    addParameters(&descriptor, 1);
+}
+
+void ESP32WebConfig::addParameters(const ConfigParameterDescriptor* descriptors, size_t count) {
+    parameters.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        parameters.add(&descriptors[i]);
     }
 }
 
 // ===== SPECIALIZED PARAMETERS =====
 
-void ESP32WebConfig::addTextParameter(const String& key, const String& label, 
-                                     const String& defaultValue, const String& placeholder) {
-    addParameter(key, label, PARAM_TEXT, defaultValue);
-    if (!placeholder.isEmpty()) {
-        setParameterAttributes(key, "placeholder='" + placeholder + "'");
+ParamHandle<String> ESP32WebConfig::addTextParameter(const String& key, const String& label, 
+                                                    const String& defaultValue, const String& placeholder) {
+    ConfigParameter* param = appendParameter(key, label, PARAM_TEXT, defaultValue);
+    if (param && !placeholder.isEmpty()) {
+        parameters.setString(*param, DESC_ATTRIBUTES, "placeholder='" + placeholder + "'");
     }
+    return handleTo<String>(param);
 }
 
 void ESP32WebConfig::addPasswordParameter(const String& key, const String& label) {
-    addParameter(key, label, PARAM_PASSWORD, "");
+    appendParameter(key, label, PARAM_PASSWORD, "");
 }
 
-void ESP32WebConfig::addNumberParameter(const String& key, const String& label, 
-                                       int defaultValue, int min, int max, int step) {
-    addParameter(key, label, PARAM_NUMBER, String(defaultValue));
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.minValue = min;
-            param.maxValue = max;
-            param.step = step;
-            break;
-        }
+ParamHandle<int> ESP32WebConfig::addNumberParameter(const String& key, const String& label, 
+                                                   int defaultValue, int min, int max, int step) {
+    ConfigParameter* param = appendParameter(key, label, PARAM_NUMBER, String(defaultValue));
+    if (param) {
+        ConfigParameterDescriptor* descriptor = parameters.edit(*param);
+        descriptor->minValue = min;
+        descriptor->maxValue = max;
+        descriptor->step = step;
     }
+    return handleTo<int>(param);
 }
 
-void ESP32WebConfig::addFloatParameter(const String& key, const String& label, 
-                                      float defaultValue, float min, float max, float step) {
-    addParameter(key, label, PARAM_FLOAT, String(defaultValue, 2));
-    setParameterAttributes(key, "min='" + String(min, 2) + "' max='" + String(max, 2) + "' step='" + String(step, 2) + "'");
+ParamHandle<float> ESP32WebConfig::addFloatParameter(const String& key, const String& label, 
+                                                    float defaultValue, float min, float max, float step) {
+    ConfigParameter* param = appendParameter(key, label, PARAM_FLOAT, String(defaultValue, 2));
+    if (param) {
+        parameters.setString(*param, DESC_ATTRIBUTES,
+                             "min='" + String(min, 2) + "' max='" + String(max, 2) + "' step='" + String(step, 2) + "'");
+    }
+    return handleTo<float>(param);
 }
 
-void ESP32WebConfig::addCheckboxParameter(const String& key, const String& label, bool defaultValue) {
-    addParameter(key, label, PARAM_CHECKBOX, defaultValue ? "true" : "false");
+ParamHandle<bool> ESP32WebConfig::addCheckboxParameter(const String& key, const String& label, bool defaultValue) {
+    return handleTo<bool>(appendParameter(key, label, PARAM_CHECKBOX, defaultValue ? "true" : "false"));
 }
 
 void ESP32WebConfig::addSelectParameter(const String& key, const String& label, 
                                        const String& options, const String& defaultValue) {
-    addParameter(key, label, PARAM_SELECT, defaultValue);
-    setParameterAttributes(key, "data-options='" + options + "'");
-}
-
-void ESP32WebConfig::addRangeParameter(const String& key, const String& label, 
-                                      int defaultValue, int min, int max, int step) {
-    addParameter(key, label, PARAM_RANGE, String(defaultValue));
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.minValue = min;
-            param.maxValue = max;
-            param.step = step;
-            break;
-        }
+    ConfigParameter* param = appendParameter(key, label, PARAM_SELECT, defaultValue);
+    if (!param) return;
+    parameters.setString(*param, DESC_ATTRIBUTES, "data-options='" + options + "'");
+}
+
+ParamHandle<int> ESP32WebConfig::addRangeParameter(const String& key, const String& label, 
+                                                  int defaultValue, int min, int max, int step) {
+    ConfigParameter* param = appendParameter(key, label, PARAM_RANGE, String(defaultValue));
+    if (param) {
+        ConfigParameterDescriptor* descriptor = parameters.edit(*param);
+        descriptor->minValue = min;
+        descriptor->maxValue = max;
+        descriptor->step = step;
     }
+    return handleTo<int>(param);
 }
 
 void ESP32WebConfig::addTextareaParameter(const String& key, const String& label, 
                                          const String& defaultValue, int rows) {
-    addParameter(key, label, PARAM_TEXTAREA, defaultValue);
-    setParameterAttributes(key, "rows='" + String(rows) + "'");
+    ConfigParameter* param = appendParameter(key, label, PARAM_TEXTAREA, defaultValue);
+    if (!param) return;
+    parameters.setString(*param, DESC_ATTRIBUTES, "rows='" + String(rows) + "'");
 }
 
 // ===== ADVANCED PARAMETERS =====
 
 void ESP32WebConfig::addParameterToGroup(const String& group, const String& key, const String& label, 
                                         ParameterType type, const String& defaultValue) {
-    addParameter(key, label, type, defaultValue);
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.group = group;
-            break;
-        }
-    }
+    ConfigParameter* param = appendParameter(key, label, type, defaultValue);
+    if (param) parameters.setString(*param, DESC_GROUP, group);
 }
 
 void ESP32WebConfig::setParameterAttributes(const String& key, const String& attributes) {
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.attributes = attributes;
-            break;
-        }
+    ConfigParameter* param = findParameter(key.c_str());
+    if (param) {
+        parameters.setString(*param, DESC_ATTRIBUTES, attributes);
     }
 }
 
 void ESP32WebConfig::setParameterOrder(const String& key, int order) {
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.order = order;
-            break;
-        }
+    ConfigParameter* param = findParameter(key.c_str());
+    if (param) {
+        param->order = order;
     }
 }
 
 void ESP32WebConfig::setParameterReadOnly(const String& key, bool readOnly) {
-    for (auto& param : parameters) {
-        if (param.key == key) {
-            param.readOnly = readOnly;
-            break;
-        }
+    ConfigParameter* param = findParameter(key.c_str());
+    if (param) {
+        if (readOnly) param->flags |= WEBCONFIG_PARAM_READONLY;
+        else param->flags &= ~WEBCONFIG_PARAM_READONLY;
     }
 }
 
 // ===== PARAMETER VALUES =====
 
 String ESP32WebConfig::getValue(const String& key) {
+    WC_ALLOC_SCOPE(ALLOC_GETTER);
     return getParameterValue(key);
 }
 
+// Typed getters read the stored value in place instead of copying it
 int ESP32WebConfig::getInt(const String& key) {
-    return getParameterValue(key).toInt();
+    return getInt(key.c_str());
 }
 
 float ESP32WebConfig::getFloat(const String& key) {
-    return getParameterValue(key).toFloat();
+    return getFloat(key.c_str());
 }
 
 bool ESP32WebConfig::getBool(const String& key) {
-    String value = getParameterValue(key);
-    return (value == "true" || value == "1" || value == "on");
+    return getBool(key.c_str());
+}
+
+int ESP32WebConfig::getInt(const char* key) {
+    WC_ALLOC_SCOPE(ALLOC_GETTER);
+    ConfigParameter* param = findParameter(key);
+    return param ? param->readInt() : 0;
+}
+
+float ESP32WebConfig::getFloat(const char* key) {
+    WC_ALLOC_SCOPE(ALLOC_GETTER);
+    ConfigParameter* param = findParameter(key);
+    return param ? param->readFloat() : 0.0f;
+}
+
+bool ESP32WebConfig::getBool(const char* key) {
+    WC_ALLOC_SCOPE(ALLOC_GETTER);
+    ConfigParameter* param = findParameter(key);
+    return param ? param->readBool() : false;
+}
+
+bool ESP32WebConfig::bind(const String& key, int* variable) {
+    return bindParameter(key, variable, BIND_INT);
+}
+
+bool ESP32WebConfig::bind(const String& key, float* variable) {
+    return bindParameter(key, variable, BIND_FLOAT);
+}
+
+bool ESP32WebConfig::bind(const String& key, bool* variable) {
+    return bindParameter(key, variable, BIND_BOOL);
+}
+
+bool ESP32WebConfig::bind(const String& key, String* variable) {
+    return bindParameter(key, variable, BIND_STRING);
+}
+
+bool ESP32WebConfig::bindParameter(const String& key, void* target, WebConfigBindType type) {
+    ConfigParameter* param = parameters.find(key.c_str());
+    if (!param) return false;
+    param->binding = target;
+    param->bindType = target ? type : BIND_NONE;
+    param->parseValue();
+    return true;
 }
 
 bool ESP32WebConfig::setValue(const String& key, const String& value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
     return setParameterValue(key, value);
 }
 
 bool ESP32WebConfig::setValue(const String& key, int value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
     return setParameterValue(key, String(value));
 }
 
 bool ESP32WebConfig::setValue(const String& key, float value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
     return setParameterValue(key, String(value, 2));
 }
 
 bool ESP32WebConfig::setValue(const String& key, bool value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
     return setParameterValue(key, value ? "true" : "false");
 }
 
+// ===== PARAMETER HANDLES =====
+
+ConfigParameter* ESP32WebConfig::handleParameter(uint16_t index) {
+    return parameters.at(index);
+}
+
+int ESP32WebConfig::get(ParamHandle<int> handle) {
+    ConfigParameter* param = handleParameter(handle.index);
+    return param ? param->readInt() : 0;
+}
+
+float ESP32WebConfig::get(ParamHandle<float> handle) {
+    ConfigParameter* param = handleParameter(handle.index);
+    return param ? param->readFloat() : 0.0f;
+}
+
+bool ESP32WebConfig::get(ParamHandle<bool> handle) {
+    ConfigParameter* param = handleParameter(handle.index);
+    return param ? param->readBool() : false;
+}
+
+String ESP32WebConfig::get(ParamHandle<String> handle) {
+    WC_ALLOC_SCOPE(ALLOC_GETTER);
+    ConfigParameter* param = handleParameter(handle.index);
+    return param ? param->readString() : String();
+}
+
+// An unchanged value returns before any String is built; a bound variable
+// that differs is written back with the rest
+bool ESP32WebConfig::set(ParamHandle<int> handle, int value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
+    ConfigParameter* param = handleParameter(handle.index);
+    if (!param) return false;
+    if (param->readInt() == value) return true;
+    return setParameterValue(*param, String(value));
+}
+
+bool ESP32WebConfig::set(ParamHandle<float> handle, float value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
+    ConfigParameter* param = handleParameter(handle.index);
+    if (!param) return false;
+    if (param->readFloat() == value) return true;
+    return setParameterValue(*param, String(value, 2));
+}
+
+bool ESP32WebConfig::set(ParamHandle<bool> handle, bool value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
+    ConfigParameter* param = handleParameter(handle.index);
+    if (!param) return false;
+    if (param->readBool() == value) return true;
+    return setParameterValue(*param, value ? "true" : "false");
+}
+
+bool ESP32WebConfig::set(ParamHandle<String> handle, const String& value) {
+    WC_ALLOC_SCOPE(ALLOC_SETTER);
+    ConfigParameter* param = handleParameter(handle.index);
+    if (!param) return false;
+    if (param->readString() == value) return true;
+    return setParameterValue(*param, value);
+}
+
 // ===== CALLBACK SYSTEM =====
 
 void ESP32WebConfig::onParameterChange(OnParameterChangeCallback callback) {
@@ -286,66 +510,130 @@ void ESP32WebConfig::setCustomValidator(CustomValidatorCallback callback) {
 // ===== CONTROL =====
 
 void ESP32WebConfig::begin() {
-    Serial.println("ESP32WebConfig: Initializing...");
+    bootProfile.start();
+    WC_LOGI("ESP32WebConfig: Initializing...");
     
-    // Initialize EEPROM
-    #ifdef ESP8266
-    EEPROM.begin(eepromSize);
-    #else
-    EEPROM.begin(eepromSize);
-    #endif
+    // Initialize EEPROM; the JSON pool is allocated before load() needs it
+    {
+        WebConfigBootProfile::Scope phase(bootProfile, BOOT_EEPROM);
+        #ifdef ESP8266
+        EEPROM.begin(eepromSize);
+        #else
+        EEPROM.begin(eepromSize);
+        #endif
+        #if WEBCONFIG_ENABLE_JSON
+        jsonPool.reserve();
+        #endif
+    }
     
-    // Load configuration
-    load();
+    // Load configuration; the schema is complete, so the registry is
+    // first moved into a single allocation
+    {
+        WebConfigBootProfile::Scope phase(bootProfile, BOOT_LOAD);
+        parameters.compact();
+        load();
+    }
     
     // Initialize WiFi
+    WebConfigTrace::attachWiFiEvents();
+    attachStatusEvents();
     if (enableSTA) {
+        WebConfigBootProfile::Scope phase(bootProfile, BOOT_STA);
         initSTA();
     }
-    initAP();
+    {
+        WebConfigBootProfile::Scope phase(bootProfile, BOOT_AP);
+        initAP();
+    }
     
     // Initialize web server
-    initWebServer();
+    {
+        WebConfigBootProfile::Scope phase(bootProfile, BOOT_WEBSERVER);
+        initWebServer();
+    }
     
+    #if WEBCONFIG_ENABLE_MDNS
     // Initialize mDNS
     if (enableMDNS) {
+        WebConfigBootProfile::Scope phase(bootProfile, BOOT_MDNS);
         initMDNS();
     }
+    #endif
     
     initialized = true;
+    bootProfile.finish();
+    statusStale = true;
     
-    Serial.println("ESP32WebConfig: Initialization complete");
-    Serial.printf("AP: %s (IP: %s)\n", apSSID.c_str(), apIP.toString().c_str());
+    WC_LOGI("ESP32WebConfig: Initialization complete in %lu us", (unsigned long)bootProfile.totalMicros);
+    WC_LOGI("AP: %s (IP: %s)", apSSID.c_str(), apIP.toString().c_str());
     if (enableSTA) {
-        Serial.printf("STA: %s\n", staSSID.c_str());
+        WC_LOGI("STA: %s", staSSID.c_str());
     }
+    #if WEBCONFIG_ENABLE_MDNS
     if (enableMDNS) {
-        Serial.printf("mDNS: http://%s.local\n", mdnsName.c_str());
+        WC_LOGI("mDNS: http://%s.local", mdnsName.c_str());
     }
+    #endif
+    
+    // Startup is not a hot path, show the summary right away
+    WebConfigLog::flush();
 }
 
 void ESP32WebConfig::handle() {
     if (!initialized) return;
     
-    if (server) server->handleClient();
-    if (dnsServer) dnsServer->processNextRequest();
+    // Timing only; heap probes on every loop() pass would cost more than they tell
+    WebConfigMetrics::Scope scope(metrics, METRIC_HANDLE, false);
+    WC_TRACE_SLOW_SCOPE(METRIC_HANDLE);
+    
+    // Serve queued clients in accept order until the request or time budget runs out,
+    // so a page load's follow-up requests don't each wait for another loop() pass
+    if (server) {
+        unsigned long start = micros();
+        for (uint8_t i = 0; i < maxRequestsPerLoop; i++) {
+            uint32_t served = requestsServed;
+            {
+                WC_TRACE_SLOW_SCOPE(TRACE_HANDLE_CLIENT);
+                server->handleClient();
+            }
+            // An idle pass already waited in handleClient() (delay(1) on ESP32), don't repeat it
+            if (requestsServed == served) break;
+            if (micros() - start > handleBudgetMicros) break;
+        }
+    }
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    if (dnsServer) {
+        WC_TRACE_SLOW_SCOPE(TRACE_DNS);
+        dnsServer->processNextRequest();
+    }
+    #endif
     
     // Auto-save if needed
     if (autoSave && configChanged && (millis() - lastSave > saveDelay)) {
         save();
     }
+    
+    // UART output happens here, after requests are answered
+    {
+        WC_TRACE_SLOW_SCOPE(TRACE_LOG_DRAIN);
+        WebConfigLog::drain();
+    }
 }
 
 // ===== CONFIGURATION =====
 
 bool ESP32WebConfig::save() {
+    WebConfigMetrics::Scope scope(metrics, METRIC_SAVE);
+    WC_TRACE_SCOPE(METRIC_SAVE);
+    readBindings();
     bool success = saveToEEPROM();
     if (success) {
         configChanged = false;
         lastSave = millis();
-        Serial.println("ESP32WebConfig: Configuration saved");
+        WC_LOGI("ESP32WebConfig: Configuration saved");
         
         if (onConfigSaveCallback) {
+            WC_TRACE_SCOPE(TRACE_CALLBACK_SAVE);
             onConfigSaveCallback();
         }
     }
@@ -353,22 +641,25 @@ bool ESP32WebConfig::save() {
 }
 
 bool ESP32WebConfig::load() {
+    WebConfigMetrics::Scope scope(metrics, METRIC_LOAD);
+    WC_TRACE_SCOPE(METRIC_LOAD);
     bool success = loadFromEEPROM();
     if (success) {
-        Serial.println("ESP32WebConfig: Configuration loaded");
+        WC_LOGI("ESP32WebConfig: Configuration loaded");
         
         if (onConfigLoadCallback) {
+            WC_TRACE_SCOPE(TRACE_CALLBACK_LOAD);
             onConfigLoadCallback();
         }
     } else {
-        Serial.println("ESP32WebConfig: Using default configuration");
+        WC_LOGW("ESP32WebConfig: Using default configuration");
         setDefaults();
     }
     return success;
 }
 
 void ESP32WebConfig::reset() {
-    Serial.println("ESP32WebConfig: Resetting configuration");
+    WC_LOGI("ESP32WebConfig: Resetting configuration");
     clearEEPROM();
     setDefaults();
     save();
@@ -376,41 +667,42 @@ void ESP32WebConfig::reset() {
 
 void ESP32WebConfig::setDefaults() {
     for (auto& param : parameters) {
-        param.value = param.defaultValue;
+        param.value = param.getDefaultValue();
+        param.parseValue();
     }
     configChanged = true;
 }
 
 // ===== EXPORT/IMPORT =====
 
+#if WEBCONFIG_ENABLE_JSON
 String ESP32WebConfig::exportConfig() {
-    JsonDocument doc;
+    readBindings();
+    JsonDocument doc(&jsonPool);
     doc["device"] = deviceName;
     doc["version"] = ESP32WEBCONFIG_VERSION;
     doc["timestamp"] = millis();
     
     JsonObject config = doc["config"];
     for (const auto& param : parameters) {
-        config[param.key] = param.value;
+        config[WC_JSON_KEY(param)] = param.value;
     }
     
-    String output;
-    serializeJson(doc, output);
-    return output;
+    return toJsonString(doc);
 }
 
 bool ESP32WebConfig::importConfig(const String& json) {
-    JsonDocument doc;
+    JsonDocument doc(&jsonPool);
     DeserializationError error = deserializeJson(doc, json);
     
     if (error) {
-        Serial.printf("ESP32WebConfig: JSON parsing error: %s\n", error.c_str());
+        WC_LOGE("ESP32WebConfig: JSON parsing error: %s", error.c_str());
         return false;
     }
     
     JsonObject config = doc["config"];
     if (config.isNull()) {
-        Serial.println("ESP32WebConfig: Invalid configuration format");
+        WC_LOGE("ESP32WebConfig: Invalid configuration format");
         return false;
     }
     
@@ -420,9 +712,10 @@ bool ESP32WebConfig::importConfig(const String& json) {
     }
     
     configChanged = true;
-    Serial.println("ESP32WebConfig: Configuration imported");
+    WC_LOGI("ESP32WebConfig: Configuration imported");
     return true;
 }
+#endif
 
 // ===== INFORMATION =====
 
@@ -460,69 +753,152 @@ int ESP32WebConfig::getParameterCount() {
 std::vector<String> ESP32WebConfig::getParameterKeys() {
     std::vector<String> keys;
     for (const auto& param : parameters) {
-        keys.push_back(param.key);
+        keys.push_back(param.getKey());
     }
     return keys;
 }
 
+#if WEBCONFIG_ENABLE_CAPTIVE_DNS
+uint32_t ESP32WebConfig::getDNSQueryCount() {
+    return dnsServer ? dnsServer->getQueriesAnswered() : 0;
+}
+
+uint32_t ESP32WebConfig::getDNSTimeMicros() {
+    return dnsServer ? dnsServer->getTimeSpentMicros() : 0;
+}
+
+uint32_t ESP32WebConfig::getCaptiveProbeCount() {
+    return captiveProbeCount;
+}
+#endif
+
+const WebConfigBootProfile& ESP32WebConfig::getBootProfile() {
+    return bootProfile;
+}
+
+#if WEBCONFIG_ENABLE_JSON
+WebConfigJsonPool& ESP32WebConfig::getJsonPool() {
+    return jsonPool;
+}
+#endif
+
+const WebConfigMetrics& ESP32WebConfig::getMetrics() {
+    return metrics;
+}
+
 void ESP32WebConfig::printConfig() {
+    readBindings();
     Serial.println("=== ESP32WebConfig - Current Configuration ===");
     for (const auto& param : parameters) {
-        Serial.printf("%s = %s\n", param.key.c_str(), param.value.c_str());
+        Serial.printf("%s = %s\n", param.getKey().c_str(), param.value.c_str());
     }
     Serial.println("============================================");
 }
 
 // ===== UTILITY FUNCTIONS =====
 
-String ESP32WebConfig::getParameterValue(const String& key) {
-    for (const auto& param : parameters) {
-        if (param.key == key) {
-            return param.value;
+// Reads leave bound variables alone; they are taken over by save(),
+// export and the JSON endpoints, so a getter never marks the config dirty
+ConfigParameter* ESP32WebConfig::findParameter(const char* key) {
+    return parameters.find(key);
+}
+
+// Bound variables are written by the application directly, so they are
+// validated like any other new value; numbers out of range are pulled to
+// the nearest bound
+static void clampToBounds(const ConfigParameterDescriptor& meta, String& value) {
+    switch (meta.type) {
+        case PARAM_NUMBER:
+        case PARAM_RANGE: {
+            int val = value.toInt();
+            if (val < meta.minValue) value = String(meta.minValue);
+            else if (val > meta.maxValue) value = String(meta.maxValue);
+            break;
+        }
+        case PARAM_FLOAT: {
+            if (!meta.floatBounds) break;
+            // NaN is left as it is and rejected by validateParameter()
+            float val = value.toFloat();
+            if (val < meta.minFloat) value = String(meta.minFloat, 2);
+            else if (val > meta.maxFloat) value = String(meta.maxFloat, 2);
+            break;
         }
+        default:
+            break;
     }
-    return "";
 }
 
-bool ESP32WebConfig::setParameterValue(const String& key, const String& value) {
+void ESP32WebConfig::readBindings() {
     for (auto& param : parameters) {
-        if (param.key == key) {
-            String oldValue = param.value;
-            
-            // Validation
-            if (!validateParameter(param, value)) {
-                return false;
-            }
-            
+        if (!param.bindingChanged()) continue;
+        String value = param.readString();
+        clampToBounds(param.meta(), value);
+        if (!validateParameter(param, value)) {
+            WC_LOGW("Bound %s = %s rejected, keeping %s", param.getKey().c_str(), value.c_str(), param.value.c_str());
+        } else if (value != param.value) {
             param.value = value;
             configChanged = true;
-            lastSave = millis();
-            
-            // Callback
-            if (onParameterChangeCallback) {
-                onParameterChangeCallback(key, oldValue, value);
-            }
-            
-            return true;
         }
+        // The variable gets the value actually kept
+        param.parseValue();
     }
-    return false;
+}
+
+String ESP32WebConfig::getParameterValue(const String& key) {
+    ConfigParameter* param = findParameter(key.c_str());
+    return param ? param->readString() : String();
+}
+
+bool ESP32WebConfig::setParameterValue(const String& key, const String& value) {
+    ConfigParameter* param = findParameter(key.c_str());
+    return param && setParameterValue(*param, value);
+}
+
+bool ESP32WebConfig::setParameterValue(ConfigParameter& param, const String& value) {
+    // The old value is only needed by the change callback
+    String oldValue;
+    if (onParameterChangeCallback) oldValue = param.value;
+    
+    // Validation
+    if (!validateParameter(param, value)) {
+        WC_LOGD("Rejected %s = %s", param.getKey().c_str(), value.c_str());
+        return false;
+    }
+    
+    param.value = value;
+    param.parseValue();
+    WC_LOGD("Set %s = %s", param.getKey().c_str(), value.c_str());
+    configChanged = true;
+    lastSave = millis();
+    
+    // Callback
+    if (onParameterChangeCallback) {
+        WC_TRACE_SCOPE(TRACE_CALLBACK_CHANGE);
+        onParameterChangeCallback(param.getKey(), oldValue, value);
+    }
+    
+    return true;
 }
 
 bool ESP32WebConfig::validateParameter(const ConfigParameter& param, const String& value) {
+    ConfigParameterDescriptor meta = param.meta();
+    
     // Basic validation by type
-    switch (param.type) {
+    switch (meta.type) {
         case PARAM_NUMBER:
         case PARAM_RANGE: {
             int val = value.toInt();
-            if (val < param.minValue || val > param.maxValue) {
+            if (val < meta.minValue || val > meta.maxValue) {
                 return false;
             }
             break;
         }
         case PARAM_FLOAT: {
+            // Written so that NaN fails the check too
             float val = value.toFloat();
-            // For float we use attributes for min/max
+            if (meta.floatBounds && !(val >= meta.minFloat && val <= meta.maxFloat)) {
+                return false;
+            }
             break;
         }
         case PARAM_EMAIL: {
@@ -534,15 +910,17 @@ bool ESP32WebConfig::validateParameter(const ConfigParameter& param, const Strin
     }
     
     // Required field
-    if (param.required && value.isEmpty()) {
+    if (meta.required && value.isEmpty()) {
         return false;
     }
     
     // Custom validator
     if (customValidator) {
-        String error = customValidator(param.key, value);
+        WC_TRACE_SCOPE(TRACE_CALLBACK_VALIDATOR);
+        String key = param.getKey();
+        String error = customValidator(key, value);
         if (!error.isEmpty()) {
-            Serial.printf("Validation error for %s: %s\n", param.key.c_str(), error.c_str());
+            WC_LOGW("Validation error for %s: %s", key.c_str(), error.c_str());
             return false;
         }
     }
@@ -561,7 +939,7 @@ void ESP32WebConfig::initAP() {
     WiFi.softAPConfig(apIP, apGateway, apSubnet);
     WiFi.softAP(apSSID.c_str(), apPassword.c_str());
     
-    Serial.printf("AP started: %s (IP: %s)\n", apSSID.c_str(), WiFi.softAPIP().toString().c_str());
+    WC_LOGI("AP started: %s (IP: %s)", apSSID.c_str(), WiFi.softAPIP().toString().c_str());
 }
 
 void ESP32WebConfig::initSTA() {
@@ -572,70 +950,79 @@ void ESP32WebConfig::initSTA() {
         WiFi.begin(staSSID.c_str(), staPassword.c_str());
     }
     
-    Serial.printf("Connecting to WiFi: %s\n", staSSID.c_str());
+    WC_LOGI("Connecting to WiFi: %s", staSSID.c_str());
 }
 
 void ESP32WebConfig::initWebServer() {
     server = new WebServer(80);
-    dnsServer = new DNSServer();
-    
-    // Setup handlers
-    server->on("/", [this]() { handleRoot(); });
-    server->on("/config", [this]() { handleConfig(); });
-    server->on("/network", [this]() { handleNetwork(); });
-    server->on("/advanced", [this]() { handleAdvanced(); });
-    server->on("/backup", [this]() { handleBackup(); });
-    server->on("/save", HTTP_POST, [this]() { handleSave(); });
-    server->on("/get", [this]() { handleGet(); });
-    server->on("/set", HTTP_POST, [this]() { handleSet(); });
-    server->on("/reset", [this]() { handleReset(); });
-    server->on("/reboot", [this]() { handleReboot(); });
-    server->on("/export", [this]() { handleExport(); });
-    server->on("/import", HTTP_POST, [this]() { handleImport(); });
-    server->on("/api/status", [this]() { 
-        server->send(200, "application/json", getStatusJSON()); 
-    });
+    
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    dnsServer = new CaptiveDNS();
+    
+    // Captive portal responses never change, build them once
+    captivePortalURL = "http://" + apIP.toString() + "/";
+    captiveProbePage = "<!DOCTYPE html><html><head><meta http-equiv='refresh' content='0;url=" + captivePortalURL +
+                       "'></head><body><a href='" + captivePortalURL + "'>" + deviceName + "</a></body></html>";
+    #endif
+    
+    // All library routes go through one hashed dispatch table
+    server->addHandler(new WebConfigRouter(this));
     server->onNotFound([this]() { handleNotFound(); });
     
+    #if WEBCONFIG_ENABLE_AUTH
+    // Session cookies need the Cookie header, which WebServer drops by default.
+    // Collected always, so enableSessionAuth() also works after begin().
+    static const char* sessionHeaders[] = { "Cookie" };
+    server->collectHeaders(sessionHeaders, 1);
+    #endif
+    
+    #if defined(ESP8266) && defined(ARDUINO_ESP8266_MAJOR) && ARDUINO_ESP8266_MAJOR >= 3
+    // Reuse the TCP connection for page, status poll and export requests
+    server->keepAlive(true);
+    #endif
+    
     server->begin();
     
-    // DNS server for captive portal
-    dnsServer->start(53, "*", apIP);
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    // DNS server for captive portal, idle while no station is on the AP
+    dnsServer->setAutoSuspend(dnsAutoSuspend);
+    dnsServer->start(apIP);
+    #endif
     
-    Serial.println("Web server started on port 80");
+    WC_LOGI("Web server started on port 80");
 }
 
+#if WEBCONFIG_ENABLE_MDNS
 void ESP32WebConfig::initMDNS() {
     #ifdef ESP8266
     if (MDNS.begin(mdnsName.c_str())) {
         MDNS.addService("http", "tcp", 80);
-        Serial.printf("mDNS started: http://%s.local\n", mdnsName.c_str());
+        WC_LOGI("mDNS started: http://%s.local", mdnsName.c_str());
     }
     #else
     if (MDNS.begin(mdnsName.c_str())) {
         MDNS.addService("http", "tcp", 80);
-        Serial.printf("mDNS started: http://%s.local\n", mdnsName.c_str());
+        WC_LOGI("mDNS started: http://%s.local", mdnsName.c_str());
     }
     #endif
 }
+#endif
 
 // ===== WEB HANDLERS =====
 
+#if WEBCONFIG_ENABLE_PAGES
 void ESP32WebConfig::handleRoot() {
     if (!authenticate()) return;
     
-    String html = getMainPageHTML();
-    html = replacePlaceholders(html);
-    server->send(200, "text/html", html);
+    sendPage(getMainPageHTML());
 }
 
 void ESP32WebConfig::handleConfig() {
     if (!authenticate()) return;
     
-    String html = getConfigPageHTML();
-    html = replacePlaceholders(html);
-    server->send(200, "text/html", html);
+    sendPage(getConfigPageHTML());
 }
+#endif
 
 void ESP32WebConfig::handleSave() {
     if (!authenticate()) return;
@@ -643,19 +1030,16 @@ void ESP32WebConfig::handleSave() {
     if (server->method() == HTTP_POST) {
         // Save all parameters from form
         bool hasChanges = false;
+        readBindings();
         
-        for (auto& param : parameters) {
-            if (server->hasArg(param.key)) {
-                String newValue = server->arg(param.key);
-                if (param.type == PARAM_CHECKBOX) {
-                    newValue = server->hasArg(param.key) ? "true" : "false";
-                }
-                
-                if (param.value != newValue) {
-                    if (setParameterValue(param.key, newValue)) {
-                        hasChanges = true;
-                    }
-                }
+        // Walks the submitted fields, so no key String is built per parameter
+        for (int i = 0; i < server->args(); i++) {
+            ConfigParameter* param = parameters.find(server->argName(i).c_str());
+            if (!param) continue;
+            
+            String newValue = param->getType() == PARAM_CHECKBOX ? String("true") : server->arg(i);
+            if (param->value != newValue && setParameterValue(*param, newValue)) {
+                hasChanges = true;
             }
         }
         
@@ -663,7 +1047,7 @@ void ESP32WebConfig::handleSave() {
             save();
         }
         
-        server->send(200, "text/html", 
+        sendResponse(200, "text/html", 
             "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>Saved</title>"
             "<meta http-equiv='refresh' content='3;url=/'></head><body>"
             "<h1>✅ Configuration saved!</h1>"
@@ -672,46 +1056,166 @@ void ESP32WebConfig::handleSave() {
     }
 }
 
+#if WEBCONFIG_ENABLE_JSON
 void ESP32WebConfig::handleExport() {
     if (!authenticate()) return;
     
     String config = exportConfig();
-    server->sendHeader("Content-Disposition", "attachment; filename=\"" + deviceName + "_config.json\"");
-    server->send(200, "application/json", config);
+    const char* disposition = requestArena.format("attachment; filename=\"%s_config.json\"", deviceName.c_str());
+    if (disposition) server->sendHeader("Content-Disposition", disposition);
+    sendResponse(200, "application/json", config);
 }
+#endif
 
 void ESP32WebConfig::handleNotFound() {
+    WebConfigMetrics::Scope scope(metrics, METRIC_NOT_FOUND);
+    WC_TRACE_SCOPE(METRIC_NOT_FOUND);
+    requestsServed++;
+    
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
     // Captive portal redirect
-    server->sendHeader("Location", "http://" + apIP.toString(), true);
-    server->send(302, "text/plain", "");
+    server->sendHeader("Location", captivePortalURL, true);
+    sendResponse(302, "text/plain", "");
+    #else
+    sendResponse(404, "text/plain", "Not found");
+    #endif
+}
+
+void ESP32WebConfig::handleLog() {
+    if (!authenticate()) return;
+    
+    // ?since=<n> returns only lines the client has not seen yet
+    uint32_t since = server->hasArg("since") ? strtoul(server->arg("since").c_str(), nullptr, 10) : 0;
+    String output;
+    output.reserve(WEBCONFIG_LOG_LINES * 48);
+    uint32_t next = WebConfigLog::copyRecent(output, since);
+    
+    server->sendHeader("X-Log-Next", String(next));
+    sendResponse(200, "text/plain", output);
+}
+
+void ESP32WebConfig::handleTrace() {
+    if (!authenticate()) return;
+    
+    server->sendHeader("Content-Disposition", "attachment; filename=\"trace.bin\"");
+    metrics.addBytesSent(WebConfigTrace::send(*server));
+    if (server->hasArg("clear")) {
+        WebConfigTrace::clear();
+    }
+}
+
+void ESP32WebConfig::handleMetrics() {
+    #if !WEBCONFIG_METRICS_PUBLIC
+    if (!authenticate()) return;
+    #endif
+    
+    sendResponse(200, "text/plain; version=0.0.4", metrics.toPrometheus());
+}
+
+void ESP32WebConfig::sendResponse(int code, const char* contentType, const String& content) {
+    server->send(code, contentType, content);
+    metrics.addBytesSent(content.length());
+}
+
+// Literal bodies are sent as they are, without a String copy
+void ESP32WebConfig::sendResponse(int code, const char* contentType, const char* content) {
+    server->send_P(code, contentType, content);
+    metrics.addBytesSent(strlen_P(content));
+}
+
+void ESP32WebConfig::handleStatus() {
+    sendResponse(200, "application/json", getStatusJSON());
+}
+
+void ESP32WebConfig::handleConfigValue(const char* key) {
+    if (!authenticate()) return;
+    
+    ConfigParameter* target = findParameter(key);
+    if (!target) {
+        sendResponse(404, "application/json", "{\"error\":\"Unknown parameter\"}");
+        return;
+    }
+    
+    HTTPMethod method = server->method();
+    if (method == HTTP_POST || method == HTTP_PUT) {
+        String value = server->hasArg("value") ? server->arg("value") : server->arg("plain");
+        if (!setParameterValue(*target, value)) {
+            sendResponse(400, "application/json", "{\"error\":\"Invalid value\"}");
+            return;
+        }
+    }
+    
+    #if WEBCONFIG_ENABLE_JSON
+    JsonDocument doc(&jsonPool);
+    doc["key"] = key;
+    doc["value"] = target->readString();
+    
+    String output = toJsonString(doc);
+    #else
+    String output = "{\"key\":";
+    appendJsonString(output, key);
+    output += ",\"value\":";
+    appendJsonString(output, target->readString());
+    output += '}';
+    #endif
+    sendResponse(200, "application/json", output);
 }
 
+#if WEBCONFIG_ENABLE_CAPTIVE_DNS
+void ESP32WebConfig::handleCaptiveProbe() {
+    // Any answer other than the expected one makes the OS open its portal browser;
+    // the tiny page then forwards to the real UI only when the user looks at it
+    captiveProbeCount++;
+    sendResponse(200, "text/html", captiveProbePage);
+}
+#endif
+
 bool ESP32WebConfig::authenticate() {
+    #if !WEBCONFIG_ENABLE_AUTH
+    return true;
+    #else
+    // A valid session cookie skips Basic auth decoding entirely
+    if (sessionAuth && session.verifyCookieHeader(server->header("Cookie").c_str())) {
+        return true;
+    }
+    
     if (!server->authenticate(adminUsername.c_str(), adminPassword.c_str())) {
         server->requestAuthentication();
         return false;
     }
+    
+    if (sessionAuth) {
+        char cookie[WEBCONFIG_SESSION_COOKIE_LEN];
+        if (session.issueCookie(cookie, sizeof(cookie))) {
+            server->sendHeader("Set-Cookie", cookie);
+        }
+    }
     return true;
+    #endif
 }
 
 // ===== EEPROM FUNCTIONS =====
 
+#if WEBCONFIG_ENABLE_JSON
 bool ESP32WebConfig::saveToEEPROM() {
-    JsonDocument doc;
+    JsonDocument doc(&jsonPool);
     doc["magic"] = WEBCONFIG_MAGIC_NUMBER;
     doc["version"] = ESP32WEBCONFIG_VERSION;
     
     JsonObject config = doc["config"];
     for (const auto& param : parameters) {
-        config[param.key] = param.value;
+        config[WC_JSON_KEY(param)] = param.value;
     }
     
     String output;
-    serializeJson(doc, output);
+    {
+        WC_TRACE_SCOPE(TRACE_JSON_SERIALIZE);
+        output = toJsonString(doc);
+    }
     
     // Check size
     if (output.length() > eepromSize - 4) {
-        Serial.println("ESP32WebConfig: Configuration too large for EEPROM");
+        WC_LOGE("ESP32WebConfig: Configuration too large for EEPROM");
         return false;
     }
     
@@ -723,37 +1227,45 @@ bool ESP32WebConfig::saveToEEPROM() {
         EEPROM.write(eepromStartAddr + 2 + i, output[i]);
     }
     
+    WC_TRACE_SCOPE(TRACE_EEPROM_COMMIT);
     return EEPROM.commit();
 }
 
 bool ESP32WebConfig::loadFromEEPROM() {
-    // Load size
-    uint16_t size;
+    // Load size; EEPROM.get() leaves it alone when the address is out of range
+    uint16_t size = 0;
     EEPROM.get(eepromStartAddr, size);
     
-    if (size == 0 || size > eepromSize - 4) {
+    if (size == 0 || size > eepromSize - 4 || eepromStartAddr + 2 + size > (int)EEPROM.length()) {
         return false;
     }
     
     // Load data
     String input;
     input.reserve(size);
-    for (uint16_t i = 0; i < size; i++) {
-        input += (char)EEPROM.read(eepromStartAddr + 2 + i);
+    {
+        WC_TRACE_SCOPE(TRACE_EEPROM_READ);
+        for (uint16_t i = 0; i < size; i++) {
+            input += (char)EEPROM.read(eepromStartAddr + 2 + i);
+        }
     }
     
     // Parse JSON
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, input);
+    JsonDocument doc(&jsonPool);
+    DeserializationError error;
+    {
+        WC_TRACE_SCOPE(TRACE_JSON_PARSE);
+        error = deserializeJson(doc, input);
+    }
     
     if (error) {
-        Serial.printf("ESP32WebConfig: EEPROM data parsing error: %s\n", error.c_str());
+        WC_LOGE("ESP32WebConfig: EEPROM data parsing error: %s", error.c_str());
         return false;
     }
     
     // Check magic number
     if (doc["magic"] != WEBCONFIG_MAGIC_NUMBER) {
-        Serial.println("ESP32WebConfig: Invalid EEPROM data (magic number)");
+        WC_LOGW("ESP32WebConfig: Invalid EEPROM data (magic number)");
         return false;
     }
     
@@ -766,6 +1278,76 @@ bool ESP32WebConfig::loadFromEEPROM() {
     configChanged = false;
     return true;
 }
+#else
+// Without ArduinoJson: size, magic, then "key\0value\0" records closed by an empty key
+bool ESP32WebConfig::saveToEEPROM() {
+    size_t size = 4 + 1;
+    for (const auto& param : parameters) {
+        size += param.getKey().length() + param.value.length() + 2;
+    }
+    
+    // Check size
+    if (size > (size_t)eepromSize - 4) {
+        WC_LOGE("ESP32WebConfig: Configuration too large for EEPROM");
+        return false;
+    }
+    
+    EEPROM.put(eepromStartAddr, (uint16_t)size);
+    EEPROM.put(eepromStartAddr + 2, (uint32_t)WEBCONFIG_MAGIC_NUMBER);
+    
+    int addr = eepromStartAddr + 6;
+    for (const auto& param : parameters) {
+        String key = param.getKey();
+        for (size_t i = 0; i <= key.length(); i++) {
+            EEPROM.write(addr++, i < key.length() ? key[i] : 0);
+        }
+        for (size_t i = 0; i <= param.value.length(); i++) {
+            EEPROM.write(addr++, i < param.value.length() ? param.value[i] : 0);
+        }
+    }
+    EEPROM.write(addr, 0);
+    
+    WC_TRACE_SCOPE(TRACE_EEPROM_COMMIT);
+    return EEPROM.commit();
+}
+
+bool ESP32WebConfig::loadFromEEPROM() {
+    // Load size; EEPROM.get() leaves it alone when the address is out of range
+    uint16_t size = 0;
+    EEPROM.get(eepromStartAddr, size);
+    
+    // The record must lie inside both the configured area and the EEPROM
+    if (size < 5 || size > eepromSize - 4 || eepromStartAddr + 2 + size > (int)EEPROM.length()) {
+        return false;
+    }
+    
+    // Check magic number
+    uint32_t magic = 0;
+    EEPROM.get(eepromStartAddr + 2, magic);
+    if (magic != WEBCONFIG_MAGIC_NUMBER) {
+        WC_LOGW("ESP32WebConfig: Invalid EEPROM data (magic number)");
+        return false;
+    }
+    
+    // Load values
+    WC_TRACE_SCOPE(TRACE_EEPROM_READ);
+    int addr = eepromStartAddr + 6;
+    int end = eepromStartAddr + 2 + size;
+    String key, value;
+    while (addr < end) {
+        key = "";
+        value = "";
+        char c;
+        while (addr < end && (c = (char)EEPROM.read(addr++)) != 0) key += c;
+        if (key.length() == 0) break;
+        while (addr < end && (c = (char)EEPROM.read(addr++)) != 0) value += c;
+        setParameterValue(key, value);
+    }
+    
+    configChanged = false;
+    return true;
+}
+#endif
 
 void ESP32WebConfig::clearEEPROM() {
     for (int i = eepromStartAddr; i < eepromStartAddr + eepromSize; i++) {
@@ -774,60 +1356,228 @@ void ESP32WebConfig::clearEEPROM() {
     EEPROM.commit();
 }
 
-// ===== STATUS AND CONFIG JSON =====
+// ===== STATUS JSON =====
 
-String ESP32WebConfig::getStatusJSON() {
-    JsonDocument doc;
-    doc["device"] = deviceName;
-    doc["version"] = ESP32WEBCONFIG_VERSION;
-    doc["uptime"] = millis();
-    doc["wifi_connected"] = isConnected();
-    doc["wifi_ssid"] = WiFi.SSID();
-    doc["local_ip"] = getLocalIP();
-    doc["ap_ip"] = getAPIP();
-    doc["free_heap"] = ESP.getFreeHeap();
-    doc["config_changed"] = configChanged;
+// Width of the fields patched in place. Numbers are padded with spaces,
+// which JSON allows between tokens, so the body never changes length.
+#define WC_STATUS_NUMBER_WIDTH 10
+#define WC_STATUS_BOOL_WIDTH 5
+
+void ESP32WebConfig::attachStatusEvents() {
+    #ifdef ESP8266
+    // Handlers unsubscribe when destroyed, so they are kept as members
+    statusEventHandlers[0] = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP&) {
+        statusStale = true;
+    });
+    statusEventHandlers[1] = WiFi.onStationModeDisconnected([this](const WiFiEventStationModeDisconnected&) {
+        statusStale = true;
+    });
+    #else
+    // Any event may change the SSID or an address; rebuilding is rare and cheap
+    if (statusEventId) return;
+    statusEventId = WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+        (void)event;
+        (void)info;
+        statusStale = true;
+    });
+    #endif
+}
+
+void ESP32WebConfig::appendStatusField(const char* name, StatusField field, uint8_t width) {
+    statusCache += ",\"";
+    statusCache += name;
+    statusCache += "\":";
+    statusOffsets[field] = statusCache.length();
+    for (uint8_t i = 0; i < width; i++) statusCache += ' ';
+}
+
+// Fields that only change with WiFi, the device name or the boot profile
+// are written once here; the rest are left blank for patchStatus()
+void ESP32WebConfig::buildStatus() {
+    // Cleared first, so an event arriving during the build is not lost
+    statusStale = false;
+    statusConnected = isConnected();
     
-    String output;
-    serializeJson(doc, output);
-    return output;
+    statusCache = "";
+    statusCache.reserve(384);
+    statusCache += "{\"device\":";
+    appendJsonString(statusCache, deviceName);
+    statusCache += ",\"version\":\"" ESP32WEBCONFIG_VERSION "\"";
+    appendStatusField("uptime", STATUS_UPTIME, WC_STATUS_NUMBER_WIDTH);
+    statusCache += ",\"wifi_connected\":";
+    statusCache += statusConnected ? "true" : "false";
+    statusCache += ",\"wifi_ssid\":";
+    appendJsonString(statusCache, WiFi.SSID());
+    statusCache += ",\"local_ip\":\"" + getLocalIP() + "\",\"ap_ip\":\"" + getAPIP() + "\"";
+    appendStatusField("free_heap", STATUS_FREE_HEAP, WC_STATUS_NUMBER_WIDTH);
+    appendStatusField("largest_free_block", STATUS_LARGEST_BLOCK, WC_STATUS_NUMBER_WIDTH);
+    appendStatusField("config_changed", STATUS_CONFIG_CHANGED, WC_STATUS_BOOL_WIDTH);
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    appendStatusField("dns_active", STATUS_DNS_ACTIVE, WC_STATUS_BOOL_WIDTH);
+    appendStatusField("dns_queries", STATUS_DNS_QUERIES, WC_STATUS_NUMBER_WIDTH);
+    appendStatusField("dns_time_us", STATUS_DNS_TIME, WC_STATUS_NUMBER_WIDTH);
+    appendStatusField("captive_probes", STATUS_CAPTIVE_PROBES, WC_STATUS_NUMBER_WIDTH);
+    #endif
+    statusCache += ",\"boot\":";
+    bootProfile.appendJSON(statusCache);
+    statusCache += '}';
+}
+
+void ESP32WebConfig::patchStatus(StatusField field, const char* text, uint8_t width) {
+    uint16_t offset = statusOffsets[field];
+    for (uint8_t i = 0; i < width; i++) statusCache[offset + i] = text[i];
+}
+
+void ESP32WebConfig::patchStatus(StatusField field, uint32_t value) {
+    char text[WC_STATUS_NUMBER_WIDTH + 1];
+    snprintf(text, sizeof(text), "%*lu", WC_STATUS_NUMBER_WIDTH, (unsigned long)value);
+    patchStatus(field, text, WC_STATUS_NUMBER_WIDTH);
+}
+
+void ESP32WebConfig::patchStatus(StatusField field, bool value) {
+    patchStatus(field, value ? "true " : "false", WC_STATUS_BOOL_WIDTH);
 }
 
+const String& ESP32WebConfig::getStatusJSON() {
+    // The connection check also catches a change whose event was missed
+    if (statusStale || statusConnected != isConnected()) buildStatus();
+    
+    patchStatus(STATUS_UPTIME, (uint32_t)millis());
+    patchStatus(STATUS_FREE_HEAP, (uint32_t)ESP.getFreeHeap());
+    patchStatus(STATUS_LARGEST_BLOCK, (uint32_t)webConfigLargestFreeBlock());
+    patchStatus(STATUS_CONFIG_CHANGED, configChanged);
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    patchStatus(STATUS_DNS_ACTIVE, dnsServer && dnsServer->isRunning() && !dnsServer->isSuspended());
+    patchStatus(STATUS_DNS_QUERIES, getDNSQueryCount());
+    patchStatus(STATUS_DNS_TIME, getDNSTimeMicros());
+    patchStatus(STATUS_CAPTIVE_PROBES, captiveProbeCount);
+    #endif
+    return statusCache;
+}
+
+// ===== CONFIG JSON =====
+
+#if WEBCONFIG_ENABLE_JSON
 String ESP32WebConfig::getConfigJSON() {
-    JsonDocument doc;
+    readBindings();
+    JsonDocument doc(&jsonPool);
     for (const auto& param : parameters) {
-        doc[param.key] = param.value;
+        doc[WC_JSON_KEY(param)] = param.value;
     }
     
-    String output;
-    serializeJson(doc, output);
+    return toJsonString(doc);
+}
+#else
+String ESP32WebConfig::getConfigJSON() {
+    readBindings();
+    String output = "{";
+    for (const auto& param : parameters) {
+        if (output.length() > 1) output += ',';
+        appendJsonString(output, param.getKey());
+        output += ':';
+        appendJsonString(output, param.value);
+    }
+    output += '}';
     return output;
 }
+#endif
+
+// ===== PAGE RENDERING =====
 
-// ===== PLACEHOLDER REPLACEMENT =====
+#if WEBCONFIG_ENABLE_PAGES
+// Formats an address into the request arena
+static const char* formatIP(WebConfigArena& arena, const IPAddress& ip) {
+    return arena.format("%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+}
 
-String ESP32WebConfig::replacePlaceholders(String html) {
-    html.replace("%DEVICE_NAME%", deviceName);
-    html.replace("%VERSION%", ESP32WEBCONFIG_VERSION);
-    html.replace("%WIFI_SSID%", WiFi.SSID());
-    html.replace("%WIFI_IP%", getLocalIP());
-    html.replace("%AP_IP%", getAPIP());
-    html.replace("%FREE_HEAP%", String(ESP.getFreeHeap()));
-    html.replace("%UPTIME%", String(millis() / 1000));
+// Streams html with its placeholders filled in. The values are formatted
+// into the request arena and the page is sent in spans between them, so no
+// copy of the page is made. A '%' that starts no known placeholder is sent
+// as it is.
+void ESP32WebConfig::sendPage(const String& html) {
+    IPAddress localIP = isConnected() ? WiFi.localIP() : IPAddress(0, 0, 0, 0);
+    String ssid = WiFi.SSID();
+    
+    struct Placeholder {
+        const char* name;
+        const char* value;
+        size_t nameLength;
+        size_t valueLength;
+    } placeholders[] = {
+        { "%DEVICE_NAME%", deviceName.c_str() },
+        { "%VERSION%", ESP32WEBCONFIG_VERSION },
+        { "%WIFI_SSID%", ssid.c_str() },
+        { "%WIFI_IP%", formatIP(requestArena, localIP) },
+        { "%AP_IP%", formatIP(requestArena, WiFi.softAPIP()) },
+        { "%FREE_HEAP%", requestArena.format("%u", (unsigned)ESP.getFreeHeap()) },
+        { "%UPTIME%", requestArena.format("%lu", (unsigned long)(millis() / 1000)) },
+        { "%PARAM_COUNT%", requestArena.format("%u", (unsigned)parameters.size()) }
+    };
+    const size_t placeholderCount = sizeof(placeholders) / sizeof(placeholders[0]);
+    for (size_t i = 0; i < placeholderCount; i++) {
+        if (!placeholders[i].value) placeholders[i].value = "";
+        placeholders[i].nameLength = strlen(placeholders[i].name);
+        placeholders[i].valueLength = strlen(placeholders[i].value);
+    }
     
-    return html;
+    const char* text = html.c_str();
+    size_t length = html.length();
+    
+    // First pass measures the page, the second sends it
+    size_t total = 0;
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            server->setContentLength(total);
+            server->send(200, "text/html", "");
+        }
+        size_t spanStart = 0;
+        for (size_t i = 0; i < length; i++) {
+            if (text[i] != '%') continue;
+            const Placeholder* match = nullptr;
+            for (size_t p = 0; p < placeholderCount; p++) {
+                if (strncmp(text + i, placeholders[p].name, placeholders[p].nameLength) == 0) {
+                    match = &placeholders[p];
+                    break;
+                }
+            }
+            if (!match) continue;
+            
+            if (pass == 0) {
+                total += i - spanStart + match->valueLength;
+            } else {
+                if (i > spanStart) server->sendContent(text + spanStart, i - spanStart);
+                if (match->valueLength) server->sendContent(match->value, match->valueLength);
+            }
+            i += match->nameLength - 1;
+            spanStart = i + 1;
+        }
+        if (pass == 0) {
+            total += length - spanStart;
+        } else if (length > spanStart) {
+            server->sendContent(text + spanStart, length - spanStart);
+        }
+    }
+    metrics.addBytesSent(total);
 }
 
 // Placeholder implementations for missing handlers
 void ESP32WebConfig::handleNetwork() { handleRoot(); }
 void ESP32WebConfig::handleAdvanced() { handleRoot(); }
 void ESP32WebConfig::handleBackup() { handleRoot(); }
-void ESP32WebConfig::handleGet() { server->send(200, "application/json", getConfigJSON()); }
-void ESP32WebConfig::handleSet() { server->send(200, "text/plain", "OK"); }
+#endif
+void ESP32WebConfig::handleGet() { sendResponse(200, "application/json", getConfigJSON()); }
+void ESP32WebConfig::handleSet() { sendResponse(200, "text/plain", "OK"); }
+#if WEBCONFIG_ENABLE_PAGES
 void ESP32WebConfig::handleReset() { reset(); handleRoot(); }
-void ESP32WebConfig::handleReboot() { ESP.restart(); }
-void ESP32WebConfig::handleImport() { server->send(200, "text/plain", "OK"); }
-
+#else
+void ESP32WebConfig::handleReset() { reset(); sendResponse(200, "text/plain", "OK"); }
+#endif
+void ESP32WebConfig::handleReboot() { WebConfigLog::flush(); ESP.restart(); }
+#if WEBCONFIG_ENABLE_JSON
+void ESP32WebConfig::handleImport() { sendResponse(200, "text/plain", "OK"); }
+#endif
+
+#if WEBCONFIG_ENABLE_PAGES
 // Placeholder implementations for missing template functions
 String ESP32WebConfig::getMainPageHTML() { return WebPages::getMainPage(); }
 String ESP32WebConfig::getConfigPageHTML() { return WebPages::getConfigPage(); }
@@ -839,4 +1589,7 @@ String ESP32WebConfig::getGroupTitle(const String& groupName) { return groupName
 String ESP32WebConfig::generateParameterHTML(const ConfigParameter& param) { return ""; }
 String ESP32WebConfig::generateSelectOptions(const ConfigParameter& param) { return ""; }
 String ESP32WebConfig::getInputType(ParameterType type) { return "text"; }
-void ESP32WebConfig::enableDebug(bool enable) { /* TODO */ }
\ No newline at end of file
+#endif
+void ESP32WebConfig::enableDebug(bool enable) {
+    WebConfigLog::setLevel(enable ? WEBCONFIG_LOG_DEBUG : WEBCONFIG_LOG_INFO);
+}
\ No newline at end of file
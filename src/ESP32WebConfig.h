@@ -19,25 +19,33 @@
 #ifndef ESP32WEBCONFIG_H
 #define ESP32WEBCONFIG_H
 
-#ifdef ESP8266
-  #include <ESP8266WiFi.h>
-  #include <ESP8266WebServer.h>
-  #include <DNSServer.h>
-  #include <EEPROM.h>
-  #include <ESP8266mDNS.h>
-  #define WebServer ESP8266WebServer
-  #define WiFi_Mode_t WiFiMode_t
-  #define WIFI_AP_STA WIFI_AP_STA
-  #define WIFI_AP WIFI_AP
-#else
-  #include <WiFi.h>
-  #include <WebServer.h>
-  #include <DNSServer.h>
-  #include <EEPROM.h>
-  #include <ESPmDNS.h>
+#include "WebConfigPlatform.h"
+#include "WebConfigFeatures.h"
+#include "WebConfigRegistry.h"
+
+#if WEBCONFIG_ENABLE_MDNS && !defined(WEBCONFIG_HOST)
+  #ifdef ESP8266
+    #include <ESP8266mDNS.h>
+  #else
+    #include <ESPmDNS.h>
+  #endif
 #endif
 
+#if WEBCONFIG_ENABLE_JSON
 #include <ArduinoJson.h>
+#include "WebConfigJsonPool.h"
+#endif
+#if WEBCONFIG_ENABLE_CAPTIVE_DNS
+#include "CaptiveDNS.h"
+#endif
+#if WEBCONFIG_ENABLE_AUTH
+#include "WebConfigSession.h"
+#endif
+#include "WebConfigMetrics.h"
+#include "WebConfigBootProfile.h"
+#include "WebConfigAlloc.h"
+#include "WebConfigLog.h"
+#include "WebConfigTrace.h"
 #include <functional>
 #include <vector>
 #include <map>
@@ -49,42 +57,14 @@
 #define WEBCONFIG_EEPROM_SIZE 4096
 #define WEBCONFIG_MAGIC_NUMBER 0xC0FFEE
 
-// Supported parameter data types
-enum ParameterType {
-    PARAM_TEXT,         // Text input
-    PARAM_PASSWORD,     // Password input (hidden)
-    PARAM_NUMBER,       // Number input
-    PARAM_FLOAT,        // Float input
-    PARAM_CHECKBOX,     // Checkbox (true/false)
-    PARAM_SELECT,       // Select dropdown
-    PARAM_TEXTAREA,     // Larger text area
-    PARAM_COLOR,        // Color picker
-    PARAM_RANGE,        // Range slider
-    PARAM_EMAIL,        // Email input
-    PARAM_URL,          // URL input
-    PARAM_TIME,         // Time input
-    PARAM_DATE          // Date input
-};
+// HTTP servicing budget per handle() call
+#define WEBCONFIG_MAX_REQUESTS_PER_LOOP 4
+#define WEBCONFIG_HANDLE_BUDGET_US 20000
 
-// Structure for storing parameters
-struct ConfigParameter {
-    String key;                    // Parameter key
-    String label;                  // UI label
-    String description;            // Description/help text
-    ParameterType type;            // Parameter type
-    String value;                  // Current value
-    String defaultValue;           // Default value
-    String validation;             // Regex validation
-    String options;                // Options for SELECT (JSON array)
-    String attributes;             // Additional HTML attributes
-    int minValue;                  // Min value for NUMBER/RANGE
-    int maxValue;                  // Max value for NUMBER/RANGE
-    int step;                      // Step for NUMBER/RANGE
-    bool required;                 // Required parameter
-    bool readOnly;                 // Read-only parameter
-    String group;                  // Parameter group
-    int order;                     // Display order
-};
+// Chunk size of the arena for handler temporaries, reset after each request
+#ifndef WEBCONFIG_REQUEST_ARENA_SIZE
+#define WEBCONFIG_REQUEST_ARENA_SIZE 512
+#endif
 
 // Callback types
 typedef std::function<void(String key, String oldValue, String newValue)> OnParameterChangeCallback;
@@ -92,23 +72,33 @@ typedef std::function<void()> OnConfigSaveCallback;
 typedef std::function<void()> OnConfigLoadCallback;
 typedef std::function<String(String key, String value)> CustomValidatorCallback;
 
+class WebConfigRouter;
+
 // Main library class
 class ESP32WebConfig {
+    friend class WebConfigRouter;
+    
 private:
     // Web server and DNS
     WebServer* server;
-    DNSServer* dnsServer;
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    CaptiveDNS* dnsServer;
+    #endif
     
     // Configuration
-    std::vector<ConfigParameter> parameters;
+    WebConfigRegistry parameters;
     String apSSID;
     String apPassword;
     IPAddress apIP;
     IPAddress apGateway; 
     IPAddress apSubnet;
     String deviceName;
+    #if WEBCONFIG_ENABLE_AUTH
     String adminUsername;
     String adminPassword;
+    bool sessionAuth;
+    WebConfigSession session;
+    #endif
     bool enableSTA;
     String staSSID;
     String staPassword;
@@ -121,8 +111,20 @@ private:
     bool autoSave;
     
     // mDNS
+    #if WEBCONFIG_ENABLE_MDNS
     String mdnsName;
     bool enableMDNS;
+    #endif
+    
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    // Captive portal DNS
+    bool dnsAutoSuspend;
+    
+    // Captive portal responses, built once in initWebServer()
+    String captivePortalURL;
+    String captiveProbePage;
+    uint32_t captiveProbeCount;
+    #endif
     
     // Callbacks
     OnParameterChangeCallback onParameterChangeCallback;
@@ -135,7 +137,42 @@ private:
     bool configChanged;
     unsigned long lastSave;
     int saveDelay;
+    uint8_t maxRequestsPerLoop;
+    uint32_t requestsServed;
+    uint32_t handleBudgetMicros;
+    WebConfigMetrics metrics;
+    WebConfigBootProfile bootProfile;
+    #if WEBCONFIG_ENABLE_JSON
+    WebConfigJsonPool jsonPool;
+    #endif
+    WebConfigArena requestArena;
+    
+    // /api/status body, rebuilt when WiFi or the device name changes; the
+    // fields below are fixed-width and patched in place on every request
+    enum StatusField : uint8_t {
+        STATUS_UPTIME,
+        STATUS_FREE_HEAP,
+        STATUS_LARGEST_BLOCK,
+        STATUS_CONFIG_CHANGED,
+        #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+        STATUS_DNS_ACTIVE,
+        STATUS_DNS_QUERIES,
+        STATUS_DNS_TIME,
+        STATUS_CAPTIVE_PROBES,
+        #endif
+        STATUS_FIELD_COUNT
+    };
+    String statusCache;
+    uint16_t statusOffsets[STATUS_FIELD_COUNT];
+    volatile bool statusStale;  // Set from the WiFi event task
+    bool statusConnected;
+    #ifdef ESP8266
+    WiFiEventHandler statusEventHandlers[2];
+    #else
+    wifi_event_id_t statusEventId;
+    #endif
     
+    #if WEBCONFIG_ENABLE_PAGES
     // HTML templates
     String getMainPageHTML();
     String getConfigPageHTML();
@@ -146,44 +183,74 @@ private:
     String getJavaScript();
     
     // Utility functions
-    String replacePlaceholders(String html);
+    void sendPage(const String& html);
     String generateParameterHTML(const ConfigParameter& param);
     String generateParameterGroupsHTML();
     String getGroupTitle(const String& groupName);
     String generateSelectOptions(const ConfigParameter& param);
     String getInputType(ParameterType type);
+    #endif
+    ConfigParameter* findParameter(const char* key);
+    ConfigParameter* appendParameter(const String& key, const String& label, ParameterType type, const String& defaultValue);
+    template <typename T> ParamHandle<T> handleTo(const ConfigParameter* param);
+    ConfigParameter* handleParameter(uint16_t index);
+    void readBindings();
     String getParameterValue(const String& key);
     bool setParameterValue(const String& key, const String& value);
+    bool setParameterValue(ConfigParameter& param, const String& value);
     bool validateParameter(const ConfigParameter& param, const String& value);
     
     // Web handlers
+    #if WEBCONFIG_ENABLE_PAGES
     void handleRoot();
     void handleConfig();
     void handleNetwork();
     void handleAdvanced();
     void handleBackup();
+    #endif
     void handleSave();
     void handleGet();
     void handleSet();
     void handleReset();
     void handleReboot();
+    #if WEBCONFIG_ENABLE_JSON
     void handleExport();
     void handleImport();
+    #endif
     void handleNotFound();
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    void handleCaptiveProbe();
+    #endif
+    void handleStatus();
+    void handleMetrics();
+    void handleLog();
+    void handleTrace();
+    void sendResponse(int code, const char* contentType, const String& content);
+    void sendResponse(int code, const char* contentType, const char* content);
+    void handleConfigValue(const char* key);
     
     // Network functions
     void initAP();
     void initSTA();
     void initWebServer();
+    #if WEBCONFIG_ENABLE_MDNS
     void initMDNS();
+    #endif
     
     // EEPROM functions
     bool saveToEEPROM();
     bool loadFromEEPROM();
     void clearEEPROM();
     
+    // Status cache
+    void attachStatusEvents();
+    void buildStatus();
+    void appendStatusField(const char* name, StatusField field, uint8_t width);
+    void patchStatus(StatusField field, const char* text, uint8_t width);
+    void patchStatus(StatusField field, uint32_t value);
+    void patchStatus(StatusField field, bool value);
+    
     // Utility
-    String getStatusJSON();
     String getConfigJSON();
     bool authenticate();
     IPAddress parseIP(const String& ip);
@@ -200,11 +267,36 @@ public:
                     IPAddress ip = IPAddress(192, 168, 4, 1));
     void setSTAConfig(const String& ssid, const String& password = "", 
                      IPAddress ip = IPAddress(0, 0, 0, 0));
+    #if WEBCONFIG_ENABLE_AUTH
     void setCredentials(const String& username, const String& password);
+    void enableSessionAuth(bool enable = true, uint32_t timeoutSeconds = WEBCONFIG_SESSION_TIMEOUT);
+    void revokeSessions();
+    #else
+    // Compiled out; kept so sketches build unchanged
+    void setCredentials(const String&, const String&) {}
+    void enableSessionAuth(bool = true, uint32_t = 0) {}
+    void revokeSessions() {}
+    #endif
+    #if WEBCONFIG_ENABLE_MDNS
     void setMDNS(const String& name);
+    #else
+    void setMDNS(const String&) {}
+    #endif
     void setEEPROM(int size = WEBCONFIG_EEPROM_SIZE, int startAddr = 0);
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    void setCaptiveDNSAutoSuspend(bool enable = true);
+    #else
+    void setCaptiveDNSAutoSuspend(bool = true) {}
+    #endif
+    void setClientServiceBudget(uint8_t maxRequests, uint32_t budgetMicros = WEBCONFIG_HANDLE_BUDGET_US);
     
     // ===== PARAMETERS =====
+    // Room for count more runtime parameters in one allocation; optional
+    void reserveParameters(size_t count);
+    // Moves the parameters into one allocation and indexes their keys;
+    // begin() does this, call it earlier when the schema is complete
+    bool compactParameters();
+    
     // Basic parameter addition
     void addParameter(const String& key, const String& label, ParameterType type, 
                      const String& defaultValue = "");
@@ -214,22 +306,26 @@ public:
                      const String& defaultValue, const String& description,
                      const String& validation = "", bool required = false);
     
-    // Specific parameter types
-    void addTextParameter(const String& key, const String& label, 
-                         const String& defaultValue = "", const String& placeholder = "");
+    // Specific parameter types; the typed ones return a handle for get()/set()
+    ParamHandle<String> addTextParameter(const String& key, const String& label, 
+                                         const String& defaultValue = "", const String& placeholder = "");
     void addPasswordParameter(const String& key, const String& label);
-    void addNumberParameter(const String& key, const String& label, 
-                           int defaultValue = 0, int min = 0, int max = 100, int step = 1);
-    void addFloatParameter(const String& key, const String& label, 
-                          float defaultValue = 0.0, float min = 0.0, float max = 100.0, float step = 0.1);
-    void addCheckboxParameter(const String& key, const String& label, bool defaultValue = false);
+    ParamHandle<int> addNumberParameter(const String& key, const String& label, 
+                                        int defaultValue = 0, int min = 0, int max = 100, int step = 1);
+    ParamHandle<float> addFloatParameter(const String& key, const String& label, 
+                                         float defaultValue = 0.0, float min = 0.0, float max = 100.0, float step = 0.1);
+    ParamHandle<bool> addCheckboxParameter(const String& key, const String& label, bool defaultValue = false);
     void addSelectParameter(const String& key, const String& label, 
                            const String& options, const String& defaultValue = "");
-    void addRangeParameter(const String& key, const String& label, 
-                          int defaultValue, int min, int max, int step = 1);
+    ParamHandle<int> addRangeParameter(const String& key, const String& label, 
+                                       int defaultValue, int min, int max, int step = 1);
     void addTextareaParameter(const String& key, const String& label, 
                              const String& defaultValue = "", int rows = 3);
     
+    // Parameters from const descriptor tables; only values are kept in RAM
+    void addParameter(const ConfigParameterDescriptor& descriptor);
+    void addParameters(const ConfigParameterDescriptor* descriptors, size_t count);
+    
     // Advanced parameters
     void addParameterToGroup(const String& group, const String& key, const String& label, 
                             ParameterType type, const String& defaultValue = "");
@@ -242,12 +338,40 @@ public:
     int getInt(const String& key);
     float getFloat(const String& key);
     bool getBool(const String& key);
+    // Literal keys take these and never build a String
+    int getInt(const char* key);
+    float getFloat(const char* key);
+    bool getBool(const char* key);
     
     bool setValue(const String& key, const String& value);
     bool setValue(const String& key, int value);
     bool setValue(const String& key, float value);
     bool setValue(const String& key, bool value);
     
+    // Handle access: an index into the parameter table, no key lookup.
+    // Reads return the value parsed when it was last set; an invalid
+    // handle reads as 0/false/"" and cannot be set.
+    int get(ParamHandle<int> handle);
+    float get(ParamHandle<float> handle);
+    bool get(ParamHandle<bool> handle);
+    String get(ParamHandle<String> handle);
+    bool set(ParamHandle<int> handle, int value);
+    bool set(ParamHandle<float> handle, float value);
+    bool set(ParamHandle<bool> handle, bool value);
+    bool set(ParamHandle<String> handle, const String& value);
+    
+    // Binds key to an application variable. Accepted changes from the web,
+    // API, import and load() are written to it; save, export and the getters
+    // read it back, so the application can use and change it directly.
+    // Returns false when key does not exist.
+    bool bind(const String& key, int* variable);
+    bool bind(const String& key, float* variable);
+    bool bind(const String& key, bool* variable);
+    bool bind(const String& key, String* variable);
+    
+    // Untyped form of bind(); target must point to the type named by type
+    bool bindParameter(const String& key, void* target, WebConfigBindType type);
+    
     // ===== CALLBACK SYSTEM =====
     void onParameterChange(OnParameterChangeCallback callback);
     void onConfigSave(OnConfigSaveCallback callback);
@@ -264,19 +388,38 @@ public:
     void reset();
     void setDefaults();
     
+    #if WEBCONFIG_ENABLE_JSON
     // Export/Import
     String exportConfig();
     bool importConfig(const String& json);
+    #endif
     
     // ===== INFORMATION =====
     bool isConfigChanged();
     String getVersion();
     String getDeviceName();
     bool isConnected();
+    // Body of /api/status; the reference stays valid until the next call
+    const String& getStatusJSON();
     String getLocalIP();
     String getAPIP();
     int getParameterCount();
     std::vector<String> getParameterKeys();
+    #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+    uint32_t getDNSQueryCount();
+    uint32_t getDNSTimeMicros();
+    uint32_t getCaptiveProbeCount();
+    #else
+    uint32_t getDNSQueryCount() { return 0; }
+    uint32_t getDNSTimeMicros() { return 0; }
+    uint32_t getCaptiveProbeCount() { return 0; }
+    #endif
+    const WebConfigMetrics& getMetrics();
+    const WebConfigBootProfile& getBootProfile();
+    #if WEBCONFIG_ENABLE_JSON
+    // Allocator of every JsonDocument the library builds
+    WebConfigJsonPool& getJsonPool();
+    #endif
     
     // Debug
     void printConfig();
@@ -0,0 +1,219 @@
+/*
+ * ESP32WebConfig Library - Allocation Accounting Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigAlloc.h"
+
+#if WEBCONFIG_ALLOC_TRACKING
+
+#if defined(WEBCONFIG_HOST)
+#include <new>
+#include <stdlib.h>
+#endif
+
+#if !defined(ESP8266) && !defined(WEBCONFIG_HOST)
+  #include <atomic>
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+  #define WEBCONFIG_ALLOC_RTOS 1
+  // Hooks run inside the allocator, possibly with the flash cache disabled
+  #define WEBCONFIG_ALLOC_ATTR IRAM_ATTR
+  typedef std::atomic<uint32_t> Counter32;
+#else
+  #define WEBCONFIG_ALLOC_RTOS 0
+  #define WEBCONFIG_ALLOC_ATTR
+  typedef volatile uint32_t Counter32;
+#endif
+
+static const char* const ALLOC_NAMES[ALLOC_ID_COUNT - METRIC_COUNT] = {
+    "getter", "setter", "outside", "other_task"
+};
+
+static Counter32 allocCount[ALLOC_ID_COUNT];
+static Counter32 allocBytes[ALLOC_ID_COUNT];
+static Counter32 freeCount;
+static volatile uint8_t current = ALLOC_OUTSIDE;
+
+#if WEBCONFIG_ALLOC_RTOS
+static TaskHandle_t volatile owner = nullptr;
+#endif
+
+// ===== SCOPES =====
+
+uint8_t WebConfigAlloc::enter(uint8_t id) {
+    #if WEBCONFIG_ALLOC_RTOS
+    owner = xTaskGetCurrentTaskHandle();
+    #endif
+    uint8_t previous = current;
+    current = id < ALLOC_ID_COUNT ? id : ALLOC_OUTSIDE;
+    return previous;
+}
+
+void WebConfigAlloc::leave(uint8_t previous) {
+    current = previous;
+}
+
+// ===== COUNTING =====
+
+WEBCONFIG_ALLOC_ATTR void WebConfigAlloc::noteAlloc(size_t size) {
+    uint8_t id = current;
+    #if WEBCONFIG_ALLOC_RTOS
+    TaskHandle_t task = owner;
+    if (task && xTaskGetCurrentTaskHandle() != task) id = ALLOC_OTHER_TASK;
+    #endif
+    allocCount[id] += 1;
+    allocBytes[id] += size;
+}
+
+WEBCONFIG_ALLOC_ATTR void WebConfigAlloc::noteFree() {
+    freeCount += 1;
+}
+
+WebConfigAlloc::Counter WebConfigAlloc::get(uint8_t id) {
+    Counter c = { 0, 0 };
+    if (id < ALLOC_ID_COUNT) {
+        c.count = allocCount[id];
+        c.bytes = allocBytes[id];
+    }
+    return c;
+}
+
+uint32_t WebConfigAlloc::getFrees() {
+    return freeCount;
+}
+
+uint32_t WebConfigAlloc::getTaskCount() {
+    uint32_t total = 0;
+    for (uint8_t id = 0; id < ALLOC_ID_COUNT; id++) {
+        if (id != ALLOC_OTHER_TASK) total += allocCount[id];
+    }
+    return total;
+}
+
+void WebConfigAlloc::reset() {
+    for (uint8_t id = 0; id < ALLOC_ID_COUNT; id++) {
+        allocCount[id] = 0;
+        allocBytes[id] = 0;
+    }
+    freeCount = 0;
+}
+
+bool WebConfigAlloc::isActive() {
+    #if defined(WEBCONFIG_HOST) || WEBCONFIG_ALLOC_WRAP_MALLOC || defined(CONFIG_HEAP_USE_HOOKS)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+const char* WebConfigAlloc::getName(uint8_t id) {
+    if (id < METRIC_COUNT) return WebConfigMetrics::getName((WebConfigMetricId)id);
+    if (id < ALLOC_ID_COUNT) return ALLOC_NAMES[id - METRIC_COUNT];
+    return "unknown";
+}
+
+void WebConfigAlloc::appendPrometheus(String& out) {
+    char line[128];
+    out += "# HELP webconfig_allocations_total Heap allocations per entry point\n"
+           "# TYPE webconfig_allocations_total counter\n";
+    for (uint8_t id = 0; id < ALLOC_ID_COUNT; id++) {
+        uint32_t count = allocCount[id];
+        if (!count) continue;
+        snprintf(line, sizeof(line), "webconfig_allocations_total{entry=\"%s\"} %lu\n",
+                 getName(id), (unsigned long)count);
+        out += line;
+    }
+    out += "# HELP webconfig_allocated_bytes_total Bytes requested per entry point\n"
+           "# TYPE webconfig_allocated_bytes_total counter\n";
+    for (uint8_t id = 0; id < ALLOC_ID_COUNT; id++) {
+        uint32_t bytes = allocBytes[id];
+        if (!bytes) continue;
+        snprintf(line, sizeof(line), "webconfig_allocated_bytes_total{entry=\"%s\"} %lu\n",
+                 getName(id), (unsigned long)bytes);
+        out += line;
+    }
+}
+
+// ===== ALLOCATOR HOOKS =====
+
+#if defined(CONFIG_HEAP_USE_HOOKS) && WEBCONFIG_ALLOC_RTOS
+// ESP-IDF calls these after every heap_caps allocation and free
+extern "C" WEBCONFIG_ALLOC_ATTR void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+    (void)caps;
+    if (ptr) WebConfigAlloc::noteAlloc(size);
+}
+
+extern "C" WEBCONFIG_ALLOC_ATTR void esp_heap_trace_free_hook(void* ptr) {
+    if (ptr) WebConfigAlloc::noteFree();
+}
+#endif
+
+#if WEBCONFIG_ALLOC_WRAP_MALLOC
+// Linked in place of the C allocator with -Wl,--wrap=...; realloc counts as one allocation
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    if (ptr) WebConfigAlloc::noteAlloc(size);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    if (ptr) WebConfigAlloc::noteAlloc(count * size);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    void* result = __real_realloc(ptr, size);
+    if (result && size) WebConfigAlloc::noteAlloc(size);
+    else if (ptr && !size) WebConfigAlloc::noteFree();
+    return result;
+}
+
+void __wrap_free(void* ptr) {
+    if (ptr) WebConfigAlloc::noteFree();
+    __real_free(ptr);
+}
+}
+#endif
+
+#if defined(WEBCONFIG_HOST)
+// libstdc++ calls malloc from its own shared object, out of reach of --wrap
+static void* hostAlloc(size_t size) {
+    #if WEBCONFIG_ALLOC_WRAP_MALLOC
+    void* ptr = __real_malloc(size ? size : 1);
+    #else
+    void* ptr = malloc(size ? size : 1);
+    #endif
+    if (!ptr) throw std::bad_alloc();
+    WebConfigAlloc::noteAlloc(size);
+    return ptr;
+}
+
+static void hostFree(void* ptr) {
+    if (!ptr) return;
+    WebConfigAlloc::noteFree();
+    #if WEBCONFIG_ALLOC_WRAP_MALLOC
+    __real_free(ptr);
+    #else
+    free(ptr);
+    #endif
+}
+
+void* operator new(size_t size) { return hostAlloc(size); }
+void* operator new[](size_t size) { return hostAlloc(size); }
+void operator delete(void* ptr) noexcept { hostFree(ptr); }
+void operator delete[](void* ptr) noexcept { hostFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { hostFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { hostFree(ptr); }
+#endif
+
+#endif // WEBCONFIG_ALLOC_TRACKING
@@ -0,0 +1,91 @@
+/*
+ * ESP32WebConfig Library - Allocation Accounting
+ * Counts heap allocations and attributes them to the library entry point
+ * that was running, so hot paths can be checked for zero allocations
+ *
+ * Off unless built with -DWEBCONFIG_ALLOC_TRACKING=1. Allocations reach the
+ * counters through one of:
+ *   ESP32:  ESP-IDF heap hooks, needs CONFIG_HEAP_USE_HOOKS=y in sdkconfig
+ *   ESP8266 and host: -DWEBCONFIG_ALLOC_WRAP_MALLOC=1 plus the linker flags
+ *           -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ *   Host:   operator new/delete are always replaced
+ * isActive() tells whether any of them is compiled in. Without the flag the
+ * class is not declared and WC_ALLOC_SCOPE expands to nothing.
+ *
+ * Entry points are the WebConfigMetricId values (every metrics scope is
+ * also an allocation scope) plus the ids below. Allocations made by other
+ * FreeRTOS tasks, e.g. the WiFi stack, are counted separately.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGALLOC_H
+#define WEBCONFIGALLOC_H
+
+#include "WebConfigPlatform.h"
+#include "WebConfigFeatures.h"
+#include "WebConfigMetrics.h"
+
+#ifndef WEBCONFIG_ALLOC_WRAP_MALLOC
+#define WEBCONFIG_ALLOC_WRAP_MALLOC 0
+#endif
+
+// Entry points beyond the WebConfigMetricId values
+enum WebConfigAllocId {
+    ALLOC_GETTER = METRIC_COUNT,    // getValue/getInt/getFloat/getBool
+    ALLOC_SETTER,                   // setValue overloads
+    ALLOC_OUTSIDE,                  // Library task, no library scope running
+    ALLOC_OTHER_TASK,               // Any other task
+    ALLOC_ID_COUNT
+};
+
+#if WEBCONFIG_ALLOC_TRACKING
+
+#define WC_ALLOC_CONCAT2(a, b) a##b
+#define WC_ALLOC_CONCAT(a, b) WC_ALLOC_CONCAT2(a, b)
+#define WC_ALLOC_SCOPE(id) WebConfigAlloc::Scope WC_ALLOC_CONCAT(_wcAllocScope, __LINE__)(id)
+
+class WebConfigAlloc {
+public:
+    struct Counter {
+        uint32_t count;
+        uint32_t bytes;
+    };
+
+    // Attributes allocations to id from construction to destruction
+    class Scope {
+    public:
+        explicit Scope(uint8_t id) : previous(WebConfigAlloc::enter(id)) {}
+        ~Scope() { WebConfigAlloc::leave(previous); }
+    private:
+        uint8_t previous;
+    };
+
+    // Returns the previous entry point, to be passed to leave()
+    static uint8_t enter(uint8_t id);
+    static void leave(uint8_t previous);
+
+    // Called from the allocator hooks; never allocates
+    static void noteAlloc(size_t size);
+    static void noteFree();
+
+    static Counter get(uint8_t id);
+    static uint32_t getFrees();
+
+    // Allocations made by the library task, over all entry points
+    static uint32_t getTaskCount();
+
+    static void reset();
+    static bool isActive();
+    static const char* getName(uint8_t id);
+
+    // Prometheus lines, appended by WebConfigMetrics::toPrometheus()
+    static void appendPrometheus(String& out);
+};
+
+#else
+  #define WC_ALLOC_SCOPE(id) do {} while (0)
+#endif // WEBCONFIG_ALLOC_TRACKING
+
+#endif // WEBCONFIGALLOC_H
@@ -0,0 +1,131 @@
+/*
+ * ESP32WebConfig Library - Bump Arena Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigArena.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+WebConfigArena::WebConfigArena(size_t chunkSize)
+    : head(nullptr), chunkSize(chunkSize), used(0), capacity(0), chunkCount(0) {
+}
+
+WebConfigArena::~WebConfigArena() {
+    release();
+}
+
+void* WebConfigArena::allocateFrom(Chunk* chunk, size_t size, size_t align) {
+    uintptr_t base = (uintptr_t)chunk->data();
+    uintptr_t start = (base + chunk->used + align - 1) & ~(uintptr_t)(align - 1);
+    size_t end = start - base + size;
+    if (end > chunk->size) return nullptr;
+    chunk->used = end;
+    used += size;
+    return (void*)start;
+}
+
+void* WebConfigArena::allocate(size_t size, size_t align) {
+    if (head) {
+        void* ptr = allocateFrom(head, size, align);
+        if (ptr) return ptr;
+    }
+
+    // Chunk headers keep malloc alignment, larger alignments need padding
+    size_t padding = align > sizeof(void*) ? align : 0;
+    Chunk* chunk = addChunk(size + padding);
+    return chunk ? allocateFrom(chunk, size, align) : nullptr;
+}
+
+WebConfigArena::Chunk* WebConfigArena::addChunk(size_t minimum) {
+    size_t bytes = minimum > chunkSize ? minimum : chunkSize;
+    Chunk* chunk = (Chunk*)malloc(sizeof(Chunk) + bytes);
+    if (!chunk) return nullptr;
+    chunk->next = head;
+    chunk->size = bytes;
+    chunk->used = 0;
+    head = chunk;
+    capacity += bytes;
+    chunkCount++;
+    return chunk;
+}
+
+bool WebConfigArena::reserve(size_t bytes) {
+    if (head && head->size - head->used >= bytes) return true;
+    return addChunk(bytes) != nullptr;
+}
+
+const char* WebConfigArena::copy(const char* text) {
+    if (!text || !*text) return nullptr;
+    size_t length = strlen(text) + 1;
+    char* ptr = (char*)allocate(length, 1);
+    if (ptr) memcpy(ptr, text, length);
+    return ptr;
+}
+
+const char* WebConfigArena::format(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+    if (length < 0) return nullptr;
+
+    char* ptr = (char*)allocate(length + 1, 1);
+    if (!ptr) return nullptr;
+    va_start(args, format);
+    vsnprintf(ptr, length + 1, format, args);
+    va_end(args);
+    return ptr;
+}
+
+bool WebConfigArena::owns(const void* ptr) const {
+    for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+        const uint8_t* data = chunk->data();
+        if ((const uint8_t*)ptr >= data && (const uint8_t*)ptr < data + chunk->size) return true;
+    }
+    return false;
+}
+
+void WebConfigArena::release() {
+    while (head) {
+        Chunk* next = head->next;
+        free(head);
+        head = next;
+    }
+    used = 0;
+    capacity = 0;
+    chunkCount = 0;
+}
+
+void WebConfigArena::reset() {
+    Chunk* keep = head;
+    for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+        if (chunk->size > keep->size) keep = chunk;
+    }
+    while (head) {
+        Chunk* next = head->next;
+        if (head != keep) free(head);
+        head = next;
+    }
+    head = keep;
+    used = 0;
+    capacity = 0;
+    chunkCount = 0;
+    if (keep) {
+        keep->next = nullptr;
+        keep->used = 0;
+        capacity = keep->size;
+        chunkCount = 1;
+    }
+}
+
+void WebConfigArena::swap(WebConfigArena& other) {
+    Chunk* h = head; head = other.head; other.head = h;
+    size_t u = used; used = other.used; other.used = u;
+    size_t cap = capacity; capacity = other.capacity; other.capacity = cap;
+    uint16_t n = chunkCount; chunkCount = other.chunkCount; other.chunkCount = n;
+}
@@ -0,0 +1,88 @@
+/*
+ * ESP32WebConfig Library - Bump Arena
+ * Chunked bump allocator for data that is freed all at once
+ *
+ * allocate() hands out memory from the newest chunk and adds a chunk when
+ * it is full, so returned pointers never move. There is no per-allocation
+ * free; release() or the destructor drops every chunk. A chunk is at least
+ * the configured chunk size, larger only for an allocation that would not
+ * fit otherwise. Callers that know their final size up front construct the
+ * arena with that size to get a single contiguous allocation; callers that
+ * know the size of the next batch reserve() it.
+ *
+ * An arena reused for repeated work, e.g. one per HTTP request, calls
+ * reset() instead of release(): it keeps the largest chunk, so a steady
+ * workload settles on one chunk that is never freed.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGARENA_H
+#define WEBCONFIGARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Default chunk size in bytes
+#ifndef WEBCONFIG_ARENA_CHUNK_SIZE
+#define WEBCONFIG_ARENA_CHUNK_SIZE 512
+#endif
+
+class WebConfigArena {
+public:
+    explicit WebConfigArena(size_t chunkSize = WEBCONFIG_ARENA_CHUNK_SIZE);
+    ~WebConfigArena();
+
+    // Returns nullptr when out of memory; align must be a power of two
+    void* allocate(size_t size, size_t align = sizeof(void*));
+
+    // Makes sure the newest chunk has bytes free, adding a chunk of at
+    // least that size if not; false when out of memory
+    bool reserve(size_t bytes);
+
+    // Copies a zero-terminated string; nullptr for nullptr or ""
+    const char* copy(const char* text);
+
+    // snprintf into the arena; nullptr when out of memory
+    const char* format(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Whether ptr points into one of the chunks
+    bool owns(const void* ptr) const;
+
+    // Frees all chunks
+    void release();
+
+    // Empties the arena, keeping only its largest chunk
+    void reset();
+
+    // Exchanges the chunks of both arenas, chunk sizes stay; used to replace
+    // an arena by a compacted copy
+    void swap(WebConfigArena& other);
+
+    size_t getUsed() const { return used; }
+    size_t getCapacity() const { return capacity; }
+    uint16_t getChunkCount() const { return chunkCount; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+        size_t used;
+        uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+    };
+
+    Chunk* head;        // Newest chunk, the only one allocated from
+    size_t chunkSize;
+    size_t used;        // Bytes handed out, without alignment padding
+    size_t capacity;    // Bytes in all chunks
+    uint16_t chunkCount;
+
+    void* allocateFrom(Chunk* chunk, size_t size, size_t align);
+    Chunk* addChunk(size_t minimum);
+
+    WebConfigArena(const WebConfigArena&);
+    WebConfigArena& operator=(const WebConfigArena&);
+};
+
+#endif // WEBCONFIGARENA_H
@@ -0,0 +1,73 @@
+/*
+ * ESP32WebConfig Library - Boot Profile Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigBootProfile.h"
+#include "WebConfigMetrics.h"
+
+static const char* const PHASE_NAMES[BOOT_PHASE_COUNT] = {
+    "eeprom", "load", "sta", "ap", "webserver", "mdns"
+};
+
+// ===== SCOPE =====
+
+WebConfigBootProfile::Scope::Scope(WebConfigBootProfile& profile, WebConfigBootPhase phase)
+    : profile(profile), phase(phase) {
+    heapAtStart = webConfigFreeHeap();
+    start = micros();
+}
+
+WebConfigBootProfile::Scope::~Scope() {
+    unsigned long end = micros();
+    Phase& p = profile.phases[phase];
+    p.startMicros = start - profile.startMicros;
+    p.micros = end - start;
+    p.heapDelta = (int32_t)(webConfigFreeHeap() - heapAtStart);
+}
+
+// ===== PROFILE =====
+
+WebConfigBootProfile::WebConfigBootProfile() {
+    reset();
+}
+
+void WebConfigBootProfile::reset() {
+    memset(phases, 0, sizeof(phases));
+    beginMillis = 0;
+    totalMicros = 0;
+    heapBefore = 0;
+    heapAfter = 0;
+    startMicros = 0;
+}
+
+void WebConfigBootProfile::start() {
+    reset();
+    beginMillis = millis();
+    heapBefore = webConfigFreeHeap();
+    startMicros = micros();
+}
+
+void WebConfigBootProfile::finish() {
+    totalMicros = micros() - startMicros;
+    heapAfter = webConfigFreeHeap();
+}
+
+const char* WebConfigBootProfile::getName(WebConfigBootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? PHASE_NAMES[phase] : "unknown";
+}
+
+void WebConfigBootProfile::appendJSON(String& out) const {
+    char line[96];
+    snprintf(line, sizeof(line), "{\"ready_ms\":%lu,\"total_us\":%lu,\"heap_delta\":%ld,\"phases\":{",
+             (unsigned long)readyMillis(), (unsigned long)totalMicros, (long)((int32_t)(heapAfter - heapBefore)));
+    out += line;
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        snprintf(line, sizeof(line), "%s\"%s\":{\"us\":%lu,\"heap\":%ld}", i ? "," : "",
+                 PHASE_NAMES[i], (unsigned long)phases[i].micros, (long)phases[i].heapDelta);
+        out += line;
+    }
+    out += "}}";
+}
@@ -0,0 +1,69 @@
+/*
+ * ESP32WebConfig Library - Boot Profile
+ * Duration and heap delta of each begin() phase, kept for the lifetime
+ * of the config object so it can be read back after startup
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGBOOTPROFILE_H
+#define WEBCONFIGBOOTPROFILE_H
+
+#include "WebConfigPlatform.h"
+
+// Startup phases in the order begin() runs them
+enum WebConfigBootPhase {
+    BOOT_EEPROM,
+    BOOT_LOAD,
+    BOOT_STA,
+    BOOT_AP,
+    BOOT_WEBSERVER,
+    BOOT_MDNS,
+    BOOT_PHASE_COUNT
+};
+
+struct WebConfigBootProfile {
+    struct Phase {
+        uint32_t startMicros;   // Offset from the start of begin()
+        uint32_t micros;        // 0 when the phase did not run
+        int32_t heapDelta;      // Free heap after minus before; negative = consumed
+    };
+
+    Phase phases[BOOT_PHASE_COUNT];
+    uint32_t beginMillis;       // millis() when begin() was entered, i.e. time since power-on
+    uint32_t totalMicros;       // Whole begin(), including logging between phases
+    uint32_t heapBefore;
+    uint32_t heapAfter;
+
+    // Times one phase from construction to destruction
+    class Scope {
+    public:
+        Scope(WebConfigBootProfile& profile, WebConfigBootPhase phase);
+        ~Scope();
+    private:
+        WebConfigBootProfile& profile;
+        WebConfigBootPhase phase;
+        uint32_t heapAtStart;
+        unsigned long start;
+    };
+
+    WebConfigBootProfile();
+
+    void reset();
+    void start();
+    void finish();
+
+    // Milliseconds since power-on at which begin() returned
+    uint32_t readyMillis() const { return beginMillis + totalMicros / 1000; }
+
+    static const char* getName(WebConfigBootPhase phase);
+
+    // {"ready_ms":..,"total_us":..,"heap_delta":..,"phases":{"eeprom":{"us":..,"heap":..},..}}
+    void appendJSON(String& out) const;
+
+private:
+    unsigned long startMicros;
+};
+
+#endif // WEBCONFIGBOOTPROFILE_H
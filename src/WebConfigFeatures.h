@@ -0,0 +1,54 @@
+/*
+ * ESP32WebConfig Library - Feature Switches
+ * Set any of these to 0 to leave the subsystem out of the build entirely
+ *
+ * The defines must reach every library source file, so pass them as build
+ * flags, not as #define in the sketch:
+ *   PlatformIO:  build_flags = -DWEBCONFIG_ENABLE_PAGES=0
+ *   arduino-cli: --build-property "compiler.cpp.extra_flags=-DWEBCONFIG_ENABLE_PAGES=0"
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGFEATURES_H
+#define WEBCONFIGFEATURES_H
+
+// HTML pages (/, /config, /network, /advanced, /backup), CSS and JavaScript
+#ifndef WEBCONFIG_ENABLE_PAGES
+#define WEBCONFIG_ENABLE_PAGES 1
+#endif
+
+// Captive portal DNS responder, OS probe answers and not-found redirect
+#ifndef WEBCONFIG_ENABLE_CAPTIVE_DNS
+#define WEBCONFIG_ENABLE_CAPTIVE_DNS 1
+#endif
+
+// mDNS responder (<name>.local)
+#ifndef WEBCONFIG_ENABLE_MDNS
+#define WEBCONFIG_ENABLE_MDNS 1
+#endif
+
+// ArduinoJson: /export, /import and the JSON EEPROM format; without it the
+// EEPROM holds a compact key/value list and the API writes JSON by hand
+#ifndef WEBCONFIG_ENABLE_JSON
+#define WEBCONFIG_ENABLE_JSON 1
+#endif
+
+// Basic auth and session cookies; without it every route is open
+#ifndef WEBCONFIG_ENABLE_AUTH
+#define WEBCONFIG_ENABLE_AUTH 1
+#endif
+
+// Serve /api/metrics without authentication, for scrapers that cannot send
+// credentials; off by default, the metrics expose heap and request counts
+#ifndef WEBCONFIG_METRICS_PUBLIC
+#define WEBCONFIG_METRICS_PUBLIC 0
+#endif
+
+// Heap allocation counters per entry point (WebConfigAlloc.h); debugging aid, off by default
+#ifndef WEBCONFIG_ALLOC_TRACKING
+#define WEBCONFIG_ALLOC_TRACKING 0
+#endif
+
+#endif // WEBCONFIGFEATURES_H
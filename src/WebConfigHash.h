@@ -0,0 +1,22 @@
+/*
+ * ESP32WebConfig Library - String Hash
+ * FNV-1a over a zero-terminated string, usable in constant expressions;
+ * shared by the route table and compile-time schemas, each with its own seed
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGHASH_H
+#define WEBCONFIGHASH_H
+
+#include <stdint.h>
+
+// FNV-1a offset basis
+#define WEBCONFIG_HASH_BASIS 0x811C9DC5
+
+constexpr uint32_t webConfigHash(const char* s, uint32_t h = WEBCONFIG_HASH_BASIS) {
+    return *s ? webConfigHash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+#endif // WEBCONFIGHASH_H
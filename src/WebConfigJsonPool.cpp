@@ -0,0 +1,140 @@
+/*
+ * ESP32WebConfig Library - JSON Memory Pool Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigJsonPool.h"
+
+#if WEBCONFIG_ENABLE_JSON
+
+#include "WebConfigLog.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Block sizes are rounded up to keep every header aligned
+#define WC_JSON_POOL_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+WebConfigJsonPool::WebConfigJsonPool(size_t size)
+    : buffer(nullptr), capacity(WC_JSON_POOL_ALIGN(size)), top(0), last(NO_BLOCK), live(0),
+      peak(0), allocations(0), heapFallbacks(0), inPsram(false) {
+}
+
+WebConfigJsonPool::~WebConfigJsonPool() {
+    free(buffer);
+}
+
+bool WebConfigJsonPool::reserve() {
+    if (buffer) return true;
+    #if WEBCONFIG_JSON_POOL_PSRAM && defined(ESP32) && !defined(WEBCONFIG_HOST)
+    if (psramFound()) {
+        buffer = (uint8_t*)ps_malloc(capacity);
+        inPsram = buffer != nullptr;
+    }
+    #endif
+    if (!buffer) buffer = (uint8_t*)malloc(capacity);
+    if (!buffer) {
+        WC_LOGW("WebConfigJsonPool: No memory for %u bytes, using the heap", (unsigned)capacity);
+        return false;
+    }
+    WC_LOGD("WebConfigJsonPool: %u bytes%s", (unsigned)capacity, inPsram ? " in PSRAM" : "");
+    return true;
+}
+
+void WebConfigJsonPool::resetStats() {
+    peak = top;
+    allocations = 0;
+    heapFallbacks = 0;
+}
+
+// ===== POOL =====
+
+bool WebConfigJsonPool::owns(const void* ptr) const {
+    return buffer && (const uint8_t*)ptr >= buffer && (const uint8_t*)ptr < buffer + capacity;
+}
+
+WebConfigJsonPool::Header* WebConfigJsonPool::headerOf(void* ptr) const {
+    return (Header*)ptr - 1;
+}
+
+void* WebConfigJsonPool::allocateFromPool(size_t size) {
+    if (!buffer && !reserve()) return nullptr;
+    size_t aligned = WC_JSON_POOL_ALIGN(size);
+    if (top + sizeof(Header) + aligned > capacity) return nullptr;
+
+    Header* header = (Header*)(buffer + top);
+    header->size = aligned;
+    header->previous = last;
+    last = top;
+    top += sizeof(Header) + aligned;
+    live++;
+    if (top > peak) peak = top;
+    return header + 1;
+}
+
+// Drops the newest block and every block below it that was already freed
+void WebConfigJsonPool::releaseTop() {
+    do {
+        Header* header = (Header*)(buffer + last);
+        top = last;
+        last = header->previous;
+    } while (last != NO_BLOCK && (((Header*)(buffer + last))->size & FREED_FLAG));
+}
+
+// ===== ALLOCATOR =====
+
+void* WebConfigJsonPool::allocate(size_t size) {
+    allocations++;
+    void* ptr = allocateFromPool(size);
+    if (ptr) return ptr;
+    heapFallbacks++;
+    return malloc(size);
+}
+
+void WebConfigJsonPool::deallocate(void* ptr) {
+    if (!ptr) return;
+    if (!owns(ptr)) {
+        free(ptr);
+        return;
+    }
+
+    Header* header = headerOf(ptr);
+    live--;
+    if ((uint8_t*)header - buffer == (ptrdiff_t)last) {
+        releaseTop();
+    } else {
+        header->size |= FREED_FLAG;
+    }
+    if (live == 0) {
+        top = 0;
+        last = NO_BLOCK;
+    }
+}
+
+void* WebConfigJsonPool::reallocate(void* ptr, size_t newSize) {
+    if (!ptr) return allocate(newSize);
+    if (!owns(ptr)) return realloc(ptr, newSize);
+
+    Header* header = headerOf(ptr);
+    size_t oldSize = header->size;
+    size_t aligned = WC_JSON_POOL_ALIGN(newSize);
+    size_t offset = (uint8_t*)header - buffer;
+
+    // The newest block grows or shrinks in place, others only shrink
+    if (offset == last && offset + sizeof(Header) + aligned <= capacity) {
+        header->size = aligned;
+        top = offset + sizeof(Header) + aligned;
+        if (top > peak) peak = top;
+        return ptr;
+    }
+    if (aligned <= oldSize) return ptr;
+
+    void* moved = allocate(newSize);
+    if (!moved) return nullptr;
+    memcpy(moved, ptr, oldSize);
+    deallocate(ptr);
+    return moved;
+}
+
+#endif // WEBCONFIG_ENABLE_JSON
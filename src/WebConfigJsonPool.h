@@ -0,0 +1,100 @@
+/*
+ * ESP32WebConfig Library - JSON Memory Pool
+ * ArduinoJson allocator backed by one buffer owned by the library
+ *
+ * Every JsonDocument the library builds (EEPROM save/load, export, import,
+ * status and config JSON) allocates from this pool instead of the general
+ * heap. The documents are short-lived and freed in roughly reverse order,
+ * so the pool is a bump allocator: freeing the newest block moves the top
+ * back, and the pool starts over when the last block is freed. A block
+ * freed out of order stays until the blocks above it are freed.
+ *
+ * The buffer is allocated once by begin(), or on first use, and kept. On
+ * ESP32 with PSRAM it is placed there. When a document needs more than the
+ * pool has left, the allocation falls back to the heap and is counted, so
+ * WEBCONFIG_JSON_POOL_SIZE can be tuned from getHeapFallbacks().
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGJSONPOOL_H
+#define WEBCONFIGJSONPOOL_H
+
+#include "WebConfigFeatures.h"
+
+#if WEBCONFIG_ENABLE_JSON
+
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Pool size in bytes
+#ifndef WEBCONFIG_JSON_POOL_SIZE
+  #ifdef ESP8266
+    #define WEBCONFIG_JSON_POOL_SIZE 2048
+  #else
+    #define WEBCONFIG_JSON_POOL_SIZE 6144
+  #endif
+#endif
+
+// Place the pool in PSRAM when the ESP32 has it
+#ifndef WEBCONFIG_JSON_POOL_PSRAM
+#define WEBCONFIG_JSON_POOL_PSRAM 1
+#endif
+
+class WebConfigJsonPool : public ArduinoJson::Allocator {
+public:
+    explicit WebConfigJsonPool(size_t size = WEBCONFIG_JSON_POOL_SIZE);
+    ~WebConfigJsonPool();
+
+    // Allocates the buffer; false when out of memory, documents then use the heap
+    bool reserve();
+
+    // ArduinoJson::Allocator
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    size_t getCapacity() const { return capacity; }
+    size_t getUsed() const { return top; }
+    size_t getPeak() const { return peak; }
+    uint32_t getAllocations() const { return allocations; }
+    uint32_t getHeapFallbacks() const { return heapFallbacks; }
+    bool isInPsram() const { return inPsram; }
+
+    // Clears the counters and the peak, not the pool
+    void resetStats();
+
+private:
+    // Precedes every block; size has FREED_FLAG set once freed out of order
+    struct Header {
+        uint32_t size;
+        uint32_t previous;  // Offset of the previous block's header, NO_BLOCK for the first
+    };
+
+    static const uint32_t NO_BLOCK = 0xFFFFFFFF;
+    static const uint32_t FREED_FLAG = 0x80000000;
+
+    uint8_t* buffer;
+    size_t capacity;
+    size_t top;             // Bytes in use from the start of the buffer
+    uint32_t last;          // Offset of the newest block's header
+    uint16_t live;          // Blocks not freed yet
+    size_t peak;
+    uint32_t allocations;
+    uint32_t heapFallbacks;
+    bool inPsram;
+
+    bool owns(const void* ptr) const;
+    Header* headerOf(void* ptr) const;
+    void* allocateFromPool(size_t size);
+    void releaseTop();
+
+    WebConfigJsonPool(const WebConfigJsonPool&);
+    WebConfigJsonPool& operator=(const WebConfigJsonPool&);
+};
+
+#endif // WEBCONFIG_ENABLE_JSON
+
+#endif // WEBCONFIGJSONPOOL_H
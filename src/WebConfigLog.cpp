@@ -0,0 +1,136 @@
+/*
+ * ESP32WebConfig Library - Logger Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigLog.h"
+
+static_assert((WEBCONFIG_LOG_LINES & (WEBCONFIG_LOG_LINES - 1)) == 0, "WEBCONFIG_LOG_LINES must be a power of two");
+
+#define LOG_MASK (WEBCONFIG_LOG_LINES - 1)
+
+// "[<seconds>.<ms>] X " with both numbers at the full width of unsigned,
+// so a line fits whatever the uptime
+#define LOG_PREFIX_LEN 26
+#define LOG_BUFFER_LEN (LOG_PREFIX_LEN + WEBCONFIG_LOG_LINE_LEN + 1)
+
+WebConfigLog::Line WebConfigLog::lines[WEBCONFIG_LOG_LINES];
+WebConfigLog::Counter WebConfigLog::head(0);
+uint32_t WebConfigLog::tail = 0;
+uint32_t WebConfigLog::dropped = 0;
+uint8_t WebConfigLog::level = WEBCONFIG_LOG_LEVEL < WEBCONFIG_LOG_INFO ? WEBCONFIG_LOG_LEVEL : WEBCONFIG_LOG_INFO;
+Print* WebConfigLog::output = &Serial;
+
+// ===== CONFIGURATION =====
+
+void WebConfigLog::setLevel(uint8_t lvl) {
+    level = lvl < WEBCONFIG_LOG_LEVEL ? lvl : WEBCONFIG_LOG_LEVEL;
+}
+
+void WebConfigLog::setOutput(Print* out) {
+    output = out;
+}
+
+char WebConfigLog::levelChar(uint8_t lvl) {
+    switch (lvl) {
+        case WEBCONFIG_LOG_ERROR: return 'E';
+        case WEBCONFIG_LOG_WARN:  return 'W';
+        case WEBCONFIG_LOG_INFO:  return 'I';
+        case WEBCONFIG_LOG_DEBUG: return 'D';
+        default:                  return '?';
+    }
+}
+
+// ===== WRITING =====
+
+uint32_t WebConfigLog::reserve() {
+    #ifdef ESP8266
+    return head++;
+    #else
+    return head.fetch_add(1);
+    #endif
+}
+
+void WebConfigLog::write(uint8_t lvl, const char* fmt, ...) {
+    uint32_t seq = reserve();
+    Line& line = lines[seq & LOG_MASK];
+
+    // Readers skip the slot until the text is complete
+    line.seq = 0;
+    line.entry.timestamp = millis();
+    line.entry.level = lvl;
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line.entry.text, sizeof(line.entry.text), fmt, args);
+    va_end(args);
+
+    line.seq = seq + 1;
+}
+
+// ===== READING =====
+
+bool WebConfigLog::readLine(uint32_t seq, Entry& copy) {
+    Line& line = lines[seq & LOG_MASK];
+    if (line.seq != seq + 1) return false;
+    memcpy(&copy, &line.entry, sizeof(copy));
+
+    // A writer may have lapped us while copying
+    return line.seq == seq + 1;
+}
+
+int WebConfigLog::format(char* buffer, size_t size, const Entry& entry) {
+    return snprintf(buffer, size, "[%6u.%03u] %c %s\n",
+                    (unsigned)(entry.timestamp / 1000), (unsigned)(entry.timestamp % 1000),
+                    levelChar(entry.level), entry.text);
+}
+
+size_t WebConfigLog::drain(size_t maxLines) {
+    uint32_t end = head;
+    if (!output) {
+        tail = end;
+        return 0;
+    }
+
+    size_t written = 0;
+    char buffer[LOG_BUFFER_LEN];
+    while (written < maxLines && tail != end) {
+        if (end - tail > WEBCONFIG_LOG_LINES) {
+            dropped += end - tail - WEBCONFIG_LOG_LINES;
+            tail = end - WEBCONFIG_LOG_LINES;
+        }
+
+        Entry entry;
+        if (!readLine(tail, entry)) {
+            end = head;
+            if (end - tail > WEBCONFIG_LOG_LINES) continue;   // Overwritten, resync above
+            break;                                           // Still being written
+        }
+
+        format(buffer, sizeof(buffer), entry);
+        output->print(buffer);
+        tail++;
+        written++;
+    }
+    return written;
+}
+
+uint32_t WebConfigLog::copyRecent(String& out, uint32_t since) {
+    uint32_t end = head;
+    if (since > end) since = 0;     // Device rebooted since the client's last read
+    uint32_t seq = end - since > WEBCONFIG_LOG_LINES ? end - WEBCONFIG_LOG_LINES : since;
+
+    char buffer[LOG_BUFFER_LEN];
+    for (; seq != end; seq++) {
+        Entry entry;
+        if (!readLine(seq, entry)) {
+            if (head - seq > WEBCONFIG_LOG_LINES) continue;  // Overwritten meanwhile
+            break;                                           // Still being written
+        }
+        format(buffer, sizeof(buffer), entry);
+        out += buffer;
+    }
+    return seq;
+}
@@ -0,0 +1,113 @@
+/*
+ * ESP32WebConfig Library - Logger
+ * Leveled logging into a fixed ring of lines; the caller only formats,
+ * the UART is written later from ESP32WebConfig::handle()
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGLOG_H
+#define WEBCONFIGLOG_H
+
+#include "WebConfigPlatform.h"
+#include <stdarg.h>
+
+#ifndef ESP8266
+#include <atomic>
+#endif
+
+// Log levels
+#define WEBCONFIG_LOG_NONE  0
+#define WEBCONFIG_LOG_ERROR 1
+#define WEBCONFIG_LOG_WARN  2
+#define WEBCONFIG_LOG_INFO  3
+#define WEBCONFIG_LOG_DEBUG 4
+
+// Highest level compiled in; calls above it generate no code
+#ifndef WEBCONFIG_LOG_LEVEL
+#define WEBCONFIG_LOG_LEVEL WEBCONFIG_LOG_DEBUG
+#endif
+
+// Ring size (power of two) and line length including terminator
+#ifndef WEBCONFIG_LOG_LINES
+  #ifdef ESP8266
+  #define WEBCONFIG_LOG_LINES 16
+  #else
+  #define WEBCONFIG_LOG_LINES 32
+  #endif
+#endif
+#ifndef WEBCONFIG_LOG_LINE_LEN
+#define WEBCONFIG_LOG_LINE_LEN 96
+#endif
+
+// Lines written to Serial per handle() call
+#define WEBCONFIG_LOG_DRAIN_PER_LOOP 4
+
+// Arguments are not evaluated when the level is disabled
+#define WEBCONFIG_LOG(level, fmt, ...) \
+    do { \
+        if (WEBCONFIG_LOG_LEVEL >= (level) && WebConfigLog::enabled(level)) \
+            WebConfigLog::write(level, fmt, ##__VA_ARGS__); \
+    } while (0)
+
+#define WC_LOGE(fmt, ...) WEBCONFIG_LOG(WEBCONFIG_LOG_ERROR, fmt, ##__VA_ARGS__)
+#define WC_LOGW(fmt, ...) WEBCONFIG_LOG(WEBCONFIG_LOG_WARN, fmt, ##__VA_ARGS__)
+#define WC_LOGI(fmt, ...) WEBCONFIG_LOG(WEBCONFIG_LOG_INFO, fmt, ##__VA_ARGS__)
+#define WC_LOGD(fmt, ...) WEBCONFIG_LOG(WEBCONFIG_LOG_DEBUG, fmt, ##__VA_ARGS__)
+
+class WebConfigLog {
+public:
+    // Runtime level, capped by WEBCONFIG_LOG_LEVEL
+    static void setLevel(uint8_t level);
+    static uint8_t getLevel() { return level; }
+    static bool enabled(uint8_t lvl) { return lvl <= level; }
+
+    // Copy drained lines to this output (default Serial), nullptr to keep them in RAM only
+    static void setOutput(Print* out);
+
+    // Format one line into the ring, never blocks
+    static void write(uint8_t level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    // Write up to maxLines pending lines to the output, returns lines written
+    static size_t drain(size_t maxLines = WEBCONFIG_LOG_DRAIN_PER_LOOP);
+    static void flush() { drain(WEBCONFIG_LOG_LINES); }
+
+    // Append retained lines with sequence >= since to out, returns next sequence to ask for
+    static uint32_t copyRecent(String& out, uint32_t since = 0);
+
+    static uint32_t getDropped() { return dropped; }
+    static char levelChar(uint8_t level);
+
+private:
+    #ifdef ESP8266
+    // Single core and no logging from interrupts, plain counters are enough
+    typedef volatile uint32_t Counter;
+    #else
+    typedef std::atomic<uint32_t> Counter;
+    #endif
+
+    struct Entry {
+        uint32_t timestamp;
+        uint8_t level;
+        char text[WEBCONFIG_LOG_LINE_LEN];
+    };
+
+    struct Line {
+        Counter seq;            // Sequence + 1 once the text is complete, 0 = being written
+        Entry entry;
+    };
+
+    static Line lines[WEBCONFIG_LOG_LINES];
+    static Counter head;        // Next sequence to hand out
+    static uint32_t tail;       // Next sequence to drain
+    static uint32_t dropped;
+    static uint8_t level;
+    static Print* output;
+
+    static uint32_t reserve();
+    static bool readLine(uint32_t seq, Entry& copy);
+    static int format(char* buffer, size_t size, const Entry& entry);
+};
+
+#endif // WEBCONFIGLOG_H
@@ -0,0 +1,175 @@
+/*
+ * ESP32WebConfig Library - Metrics Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigMetrics.h"
+#include "WebConfigAlloc.h"
+
+static const uint32_t BUCKET_BOUNDS_US[WEBCONFIG_METRICS_BUCKETS - 1] = {
+    100, 300, 1000, 3000, 10000, 30000, 100000, 300000, 1000000
+};
+
+static const char* const BUCKET_LABELS[WEBCONFIG_METRICS_BUCKETS] = {
+    "0.0001", "0.0003", "0.001", "0.003", "0.01", "0.03", "0.1", "0.3", "1", "+Inf"
+};
+
+static const char* const METRIC_NAMES[METRIC_COUNT] = {
+    "root", "config", "network", "advanced", "backup", "save_form", "get", "set",
+    "reset", "reboot", "export", "import", "status", "metrics", "log", "trace", "config_value",
+    "captive_probe", "not_found", "save", "load", "handle"
+};
+
+// ===== SCOPE =====
+
+WebConfigMetrics::Scope::Scope(WebConfigMetrics& metrics, WebConfigMetricId id, bool sampleHeap)
+    : metrics(metrics), id(id), previous(metrics.current), sampleHeap(sampleHeap) {
+    heapAtStart = sampleHeap ? webConfigFreeHeap() : UINT32_MAX;
+    metrics.current = id;
+    #if WEBCONFIG_ALLOC_TRACKING
+    allocPrevious = WebConfigAlloc::enter(id);
+    #endif
+    start = micros();
+}
+
+WebConfigMetrics::Scope::~Scope() {
+    uint32_t elapsed = micros() - start;
+    uint32_t freeHeap = UINT32_MAX;
+    uint32_t largestBlock = UINT32_MAX;
+    if (sampleHeap) {
+        freeHeap = webConfigFreeHeap();
+        if (heapAtStart < freeHeap) freeHeap = heapAtStart;
+        largestBlock = webConfigLargestFreeBlock();
+    }
+    metrics.record(id, elapsed, freeHeap, largestBlock);
+    metrics.current = previous;
+    #if WEBCONFIG_ALLOC_TRACKING
+    WebConfigAlloc::leave(allocPrevious);
+    #endif
+}
+
+// ===== METRICS =====
+
+WebConfigMetrics::WebConfigMetrics() {
+    reset();
+}
+
+void WebConfigMetrics::reset() {
+    memset(metrics, 0, sizeof(metrics));
+    for (auto& m : metrics) {
+        m.minFreeHeap = UINT32_MAX;
+        m.minLargestBlock = UINT32_MAX;
+    }
+    current = METRIC_COUNT;
+}
+
+uint8_t WebConfigMetrics::bucketFor(uint32_t micros) {
+    uint8_t i = 0;
+    while (i < WEBCONFIG_METRICS_BUCKETS - 1 && micros > BUCKET_BOUNDS_US[i]) i++;
+    return i;
+}
+
+void WebConfigMetrics::record(WebConfigMetricId id, uint32_t micros, uint32_t freeHeap, uint32_t largestBlock) {
+    if (id >= METRIC_COUNT) return;
+    Metric& m = metrics[id];
+    m.count++;
+    m.buckets[bucketFor(micros)]++;
+    m.sumMicros += micros;
+    if (freeHeap < m.minFreeHeap) m.minFreeHeap = freeHeap;
+    if (largestBlock < m.minLargestBlock) m.minLargestBlock = largestBlock;
+}
+
+void WebConfigMetrics::addBytesSent(size_t bytes) {
+    if (current < METRIC_COUNT) {
+        metrics[current].bytesSent += bytes;
+    }
+}
+
+const char* WebConfigMetrics::getName(WebConfigMetricId id) {
+    return id < METRIC_COUNT ? METRIC_NAMES[id] : "unknown";
+}
+
+// ===== PROMETHEUS EXPORT =====
+
+String WebConfigMetrics::toPrometheus() const {
+    String out;
+    out.reserve(4096);
+    char line[128];
+
+    out += "# HELP webconfig_free_heap_bytes Current free heap\n"
+           "# TYPE webconfig_free_heap_bytes gauge\n";
+    snprintf(line, sizeof(line), "webconfig_free_heap_bytes %lu\n", (unsigned long)webConfigFreeHeap());
+    out += line;
+    out += "# HELP webconfig_largest_free_block_bytes Current largest allocatable block\n"
+           "# TYPE webconfig_largest_free_block_bytes gauge\n";
+    snprintf(line, sizeof(line), "webconfig_largest_free_block_bytes %lu\n", (unsigned long)webConfigLargestFreeBlock());
+    out += line;
+    out += "# HELP webconfig_uptime_seconds Time since boot\n"
+           "# TYPE webconfig_uptime_seconds counter\n";
+    snprintf(line, sizeof(line), "webconfig_uptime_seconds %lu\n", (unsigned long)(millis() / 1000));
+    out += line;
+
+    out += "# HELP webconfig_op_total Calls per handler or operation\n"
+           "# TYPE webconfig_op_total counter\n";
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (!metrics[i].count) continue;
+        snprintf(line, sizeof(line), "webconfig_op_total{op=\"%s\"} %lu\n",
+                 METRIC_NAMES[i], (unsigned long)metrics[i].count);
+        out += line;
+    }
+
+    out += "# HELP webconfig_op_duration_seconds Handler or operation latency\n"
+           "# TYPE webconfig_op_duration_seconds histogram\n";
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        const Metric& m = metrics[i];
+        if (!m.count) continue;
+        uint32_t cumulative = 0;
+        for (int b = 0; b < WEBCONFIG_METRICS_BUCKETS; b++) {
+            cumulative += m.buckets[b];
+            snprintf(line, sizeof(line), "webconfig_op_duration_seconds_bucket{op=\"%s\",le=\"%s\"} %lu\n",
+                     METRIC_NAMES[i], BUCKET_LABELS[b], (unsigned long)cumulative);
+            out += line;
+        }
+        snprintf(line, sizeof(line), "webconfig_op_duration_seconds_sum{op=\"%s\"} %lu.%06lu\n",
+                 METRIC_NAMES[i], (unsigned long)(m.sumMicros / 1000000), (unsigned long)(m.sumMicros % 1000000));
+        out += line;
+        snprintf(line, sizeof(line), "webconfig_op_duration_seconds_count{op=\"%s\"} %lu\n",
+                 METRIC_NAMES[i], (unsigned long)m.count);
+        out += line;
+    }
+
+    out += "# HELP webconfig_op_response_bytes_total Response body bytes sent\n"
+           "# TYPE webconfig_op_response_bytes_total counter\n";
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (!metrics[i].count || !metrics[i].bytesSent) continue;
+        snprintf(line, sizeof(line), "webconfig_op_response_bytes_total{op=\"%s\"} %lu\n",
+                 METRIC_NAMES[i], (unsigned long)metrics[i].bytesSent);
+        out += line;
+    }
+
+    out += "# HELP webconfig_op_min_free_heap_bytes Lowest free heap seen around the operation\n"
+           "# TYPE webconfig_op_min_free_heap_bytes gauge\n";
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (metrics[i].minFreeHeap == UINT32_MAX) continue;
+        snprintf(line, sizeof(line), "webconfig_op_min_free_heap_bytes{op=\"%s\"} %lu\n",
+                 METRIC_NAMES[i], (unsigned long)metrics[i].minFreeHeap);
+        out += line;
+    }
+
+    out += "# HELP webconfig_op_min_largest_free_block_bytes Smallest largest-free-block seen after the operation\n"
+           "# TYPE webconfig_op_min_largest_free_block_bytes gauge\n";
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (metrics[i].minLargestBlock == UINT32_MAX) continue;
+        snprintf(line, sizeof(line), "webconfig_op_min_largest_free_block_bytes{op=\"%s\"} %lu\n",
+                 METRIC_NAMES[i], (unsigned long)metrics[i].minLargestBlock);
+        out += line;
+    }
+
+    #if WEBCONFIG_ALLOC_TRACKING
+    WebConfigAlloc::appendPrometheus(out);
+    #endif
+
+    return out;
+}
@@ -0,0 +1,110 @@
+/*
+ * ESP32WebConfig Library - Metrics
+ * Per-handler request counts, latency histograms, response bytes and heap
+ * low-water marks, exported in Prometheus text format
+ *
+ * All storage is static; recording a sample never allocates.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGMETRICS_H
+#define WEBCONFIGMETRICS_H
+
+#include "WebConfigPlatform.h"
+#include "WebConfigFeatures.h"
+
+// Latency histogram: 1-3-10 log scale from 100 us to 1 s, plus +Inf
+#define WEBCONFIG_METRICS_BUCKETS 10
+
+// Instrumented operations
+enum WebConfigMetricId {
+    METRIC_ROOT,
+    METRIC_CONFIG,
+    METRIC_NETWORK,
+    METRIC_ADVANCED,
+    METRIC_BACKUP,
+    METRIC_SAVE_FORM,
+    METRIC_GET,
+    METRIC_SET,
+    METRIC_RESET,
+    METRIC_REBOOT,
+    METRIC_EXPORT,
+    METRIC_IMPORT,
+    METRIC_STATUS,
+    METRIC_METRICS,
+    METRIC_LOG,
+    METRIC_TRACE,
+    METRIC_CONFIG_VALUE,
+    METRIC_CAPTIVE_PROBE,
+    METRIC_NOT_FOUND,
+    METRIC_SAVE,
+    METRIC_LOAD,
+    METRIC_HANDLE,
+    METRIC_COUNT
+};
+
+// Platform heap probes
+inline uint32_t webConfigFreeHeap() {
+    return ESP.getFreeHeap();
+}
+
+inline uint32_t webConfigLargestFreeBlock() {
+    #ifdef ESP8266
+    return ESP.getMaxFreeBlockSize();
+    #else
+    return ESP.getMaxAllocHeap();
+    #endif
+}
+
+class WebConfigMetrics {
+public:
+    struct Metric {
+        uint32_t count;
+        uint32_t buckets[WEBCONFIG_METRICS_BUCKETS];
+        uint64_t sumMicros;
+        uint32_t bytesSent;
+        uint32_t minFreeHeap;
+        uint32_t minLargestBlock;
+    };
+
+    // Times an operation from construction to destruction
+    class Scope {
+    public:
+        Scope(WebConfigMetrics& metrics, WebConfigMetricId id, bool sampleHeap = true);
+        ~Scope();
+    private:
+        WebConfigMetrics& metrics;
+        WebConfigMetricId id;
+        WebConfigMetricId previous;
+        bool sampleHeap;
+        #if WEBCONFIG_ALLOC_TRACKING
+        uint8_t allocPrevious;
+        #endif
+        uint32_t heapAtStart;
+        unsigned long start;
+    };
+
+    WebConfigMetrics();
+
+    void reset();
+    void record(WebConfigMetricId id, uint32_t micros, uint32_t freeHeap, uint32_t largestBlock);
+
+    // Attribute response body bytes to the innermost running scope
+    void addBytesSent(size_t bytes);
+
+    const Metric& get(WebConfigMetricId id) const { return metrics[id]; }
+    static const char* getName(WebConfigMetricId id);
+
+    // Prometheus text exposition format
+    String toPrometheus() const;
+
+private:
+    Metric metrics[METRIC_COUNT];
+    WebConfigMetricId current;
+
+    static uint8_t bucketFor(uint32_t micros);
+};
+
+#endif // WEBCONFIGMETRICS_H
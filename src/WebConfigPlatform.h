@@ -0,0 +1,44 @@
+/*
+ * ESP32WebConfig Library - Platform Layer
+ * Single place that selects the WiFi, web server, EEPROM and SHA-256 headers
+ *
+ * ESP8266 and ESP32 use their Arduino cores, with SHA-256 from BearSSL and
+ * mbedTLS. Defining WEBCONFIG_HOST builds against <WebConfigHost.h> instead,
+ * which provides String, IPAddress, WiFi, WebServer, RequestHandler,
+ * DNSServer, WiFiUDP, EEPROM, MDNS, ESP, Serial and millis()/micros() with
+ * the Arduino signatures used here, so the library sources compile unchanged
+ * for off-device profiling; see extras/host and CMakeLists.txt. The host has
+ * no SHA-256 library, WebConfigSession.cpp carries a portable one.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGPLATFORM_H
+#define WEBCONFIGPLATFORM_H
+
+#if defined(WEBCONFIG_HOST)
+  #include <WebConfigHost.h>
+#elif defined(ESP8266)
+  #include <ESP8266WiFi.h>
+  #include <ESP8266WebServer.h>
+  #include <DNSServer.h>
+  #include <EEPROM.h>
+  #define WebServer ESP8266WebServer
+  #define WiFi_Mode_t WiFiMode_t
+  #define WIFI_AP_STA WIFI_AP_STA
+  #define WIFI_AP WIFI_AP
+  #include <WiFiUdp.h>
+  #include <bearssl/bearssl_hash.h>
+#else
+  #include <WiFi.h>
+  #include <WebServer.h>
+  #include <DNSServer.h>
+  #include <EEPROM.h>
+  #include <WiFiUdp.h>
+  #include <esp_system.h>
+  #include <mbedtls/sha256.h>
+  #include <mbedtls/version.h>
+#endif
+
+#endif // WEBCONFIGPLATFORM_H
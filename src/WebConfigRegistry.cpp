@@ -0,0 +1,374 @@
+/*
+ * ESP32WebConfig Library - Parameter Registry Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigRegistry.h"
+#include "WebConfigHash.h"
+#include "WebConfigLog.h"
+#include <new>
+#include <math.h>
+#include <utility>
+
+static const char* ConfigParameterDescriptor::* const DESC_STRINGS[DESC_STRING_COUNT] = {
+    &ConfigParameterDescriptor::key,
+    &ConfigParameterDescriptor::label,
+    &ConfigParameterDescriptor::defaultValue,
+    &ConfigParameterDescriptor::group,
+    &ConfigParameterDescriptor::description,
+    &ConfigParameterDescriptor::validation,
+    &ConfigParameterDescriptor::options,
+    &ConfigParameterDescriptor::attributes
+};
+
+// ===== PARAMETER RECORDS =====
+
+// Descriptor strings may point into flash on ESP8266
+static String descriptorString(const char* text) {
+    if (!text) return String();
+    #ifdef ESP8266
+    return String(FPSTR(text));
+    #else
+    return String(text);
+    #endif
+}
+
+ConfigParameterDescriptor ConfigParameter::meta() const {
+    ConfigParameterDescriptor copy;
+    memcpy_P(&copy, descriptor, sizeof(copy));
+    return copy;
+}
+
+bool ConfigParameter::hasKey(const char* key) const {
+    const char* own = (const char*)pgm_read_ptr(&descriptor->key);
+    return own && strcmp_P(key, own) == 0;
+}
+
+const char* ConfigParameter::getKeyData() const {
+    return (const char*)pgm_read_ptr(&descriptor->key);
+}
+
+String ConfigParameter::getKey() const {
+    return descriptorString(getKeyData());
+}
+
+String ConfigParameter::getDefaultValue() const {
+    return descriptorString((const char*)pgm_read_ptr(&descriptor->defaultValue));
+}
+
+ParameterType ConfigParameter::getType() const {
+    return (ParameterType)pgm_read_dword(&descriptor->type);
+}
+
+static bool parseBool(const String& value) {
+    return value == "true" || value == "1" || value == "on";
+}
+
+static void parseTyped(ConfigParameter& param) {
+    const String& value = param.value;
+    switch (param.getType()) {
+        case PARAM_NUMBER:
+        case PARAM_RANGE:
+            param.parsed.intValue = value.toInt();
+            break;
+        case PARAM_FLOAT:
+            param.parsed.floatValue = value.toFloat();
+            break;
+        case PARAM_CHECKBOX:
+            param.parsed.boolValue = parseBool(value);
+            break;
+        default:
+            break;
+    }
+}
+
+void ConfigParameter::parseValue() {
+    parseTyped(*this);
+    if (!binding) return;
+    switch (bindType) {
+        case BIND_INT:
+            *(int*)binding = value.toInt();
+            break;
+        case BIND_FLOAT:
+            *(float*)binding = value.toFloat();
+            break;
+        case BIND_BOOL:
+            *(bool*)binding = parseBool(value);
+            break;
+        case BIND_STRING:
+            *(String*)binding = value;
+            break;
+    }
+}
+
+// Compares without formatting, so an unchanged variable costs no allocation
+bool ConfigParameter::bindingMatches() const {
+    switch (bindType) {
+        case BIND_INT:
+            return *(const int*)binding == value.toInt();
+        case BIND_FLOAT:
+            return fabsf(*(const float*)binding - value.toFloat()) < 0.005f;
+        case BIND_BOOL:
+            return *(const bool*)binding == parseBool(value);
+        case BIND_STRING:
+            return *(const String*)binding == value;
+        default:
+            return true;
+    }
+}
+
+// Floats are kept with two decimals, like setValue(float)
+String ConfigParameter::formatBinding() const {
+    switch (bindType) {
+        case BIND_INT:
+            return String(*(const int*)binding);
+        case BIND_FLOAT:
+            return String(*(const float*)binding, 2);
+        case BIND_BOOL:
+            return *(const bool*)binding ? "true" : "false";
+        case BIND_STRING:
+            return *(const String*)binding;
+        default:
+            return value;
+    }
+}
+
+int ConfigParameter::readInt() const {
+    if (binding && bindType == BIND_INT) return *(const int*)binding;
+    ParameterType type = getType();
+    return type == PARAM_NUMBER || type == PARAM_RANGE ? parsed.intValue : value.toInt();
+}
+
+float ConfigParameter::readFloat() const {
+    if (binding && bindType == BIND_FLOAT) return *(const float*)binding;
+    return getType() == PARAM_FLOAT ? parsed.floatValue : value.toFloat();
+}
+
+bool ConfigParameter::readBool() const {
+    if (binding && bindType == BIND_BOOL) return *(const bool*)binding;
+    return getType() == PARAM_CHECKBOX ? parsed.boolValue : parseBool(value);
+}
+
+String ConfigParameter::readString() const {
+    if (!binding || bindingMatches()) return value;
+    return formatBinding();
+}
+
+// ===== REGISTRATION =====
+
+WebConfigRegistry::WebConfigRegistry()
+    : first(nullptr), last(nullptr), count(0), compacted(true), slots(nullptr), slotMask(0) {
+}
+
+WebConfigRegistry::~WebConfigRegistry() {
+    destroyRecords();
+}
+
+void WebConfigRegistry::destroyRecords() {
+    for (Block* block = first; block; block = block->next) {
+        for (uint16_t i = 0; i < block->count; i++) {
+            block->items[i].~ConfigParameter();
+        }
+    }
+}
+
+WebConfigRegistry::Block* WebConfigRegistry::addBlock(size_t capacity, bool owned) {
+    // One chunk for the block and, for runtime parameters, what add() and
+    // setString() put in the arena next
+    size_t bytes = sizeof(Block) + alignof(Block) + capacity * sizeof(ConfigParameter) + alignof(ConfigParameter);
+    if (owned) {
+        bytes += capacity * (sizeof(ConfigParameterDescriptor) + alignof(ConfigParameterDescriptor) +
+                             WEBCONFIG_PARAM_TEXT_BYTES);
+    }
+    if (!arena.reserve(bytes)) return nullptr;
+
+    Block* block = (Block*)arena.allocate(sizeof(Block), alignof(Block));
+    if (!block) return nullptr;
+    block->items = (ConfigParameter*)arena.allocate(capacity * sizeof(ConfigParameter), alignof(ConfigParameter));
+    if (!block->items) return nullptr;
+    block->next = nullptr;
+    block->count = 0;
+    block->capacity = capacity;
+    if (last) last->next = block;
+    else first = block;
+    last = block;
+    return block;
+}
+
+void WebConfigRegistry::reserve(size_t extra, bool owned) {
+    if (last && (size_t)(last->capacity - last->count) >= extra) return;
+    addBlock(extra > WEBCONFIG_PARAM_BLOCK ? extra : WEBCONFIG_PARAM_BLOCK, owned);
+}
+
+ConfigParameterDescriptor* WebConfigRegistry::createDescriptor() {
+    void* memory = arena.allocate(sizeof(ConfigParameterDescriptor), alignof(ConfigParameterDescriptor));
+    if (!memory) return nullptr;
+    compacted = false;
+    return new (memory) ConfigParameterDescriptor();
+}
+
+ConfigParameter* WebConfigRegistry::add(const ConfigParameterDescriptor* descriptor, uint8_t flags) {
+    if (!descriptor) return nullptr;
+    if (!last || last->count == last->capacity) {
+        // Each new block doubles the capacity, so few blocks are needed
+        if (!addBlock(count > WEBCONFIG_PARAM_BLOCK ? count : WEBCONFIG_PARAM_BLOCK, flags & WEBCONFIG_PARAM_OWNED)) {
+            WC_LOGE("WebConfigRegistry: Out of memory");
+            return nullptr;
+        }
+    }
+
+    ConfigParameter* param = new (&last->items[last->count]) ConfigParameter();
+    last->count++;
+    param->descriptor = descriptor;
+    param->order = count++;
+    param->flags = flags;
+    if (param->meta().readOnly) param->flags |= WEBCONFIG_PARAM_READONLY;
+    param->value = param->getDefaultValue();
+    param->parseValue();
+    compacted = false;
+    slots = nullptr;
+    return param;
+}
+
+// ===== LOOKUP =====
+
+// webConfigHash() at runtime; reads through pgm_read_byte for flash keys
+static uint32_t keyHash(const char* key) {
+    uint32_t hash = WEBCONFIG_HASH_BASIS;
+    for (uint8_t c; (c = pgm_read_byte(key)) != 0; key++) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+ConfigParameter* WebConfigRegistry::find(const char* key) {
+    if (!key) return nullptr;
+    if (slots) {
+        for (uint32_t i = keyHash(key) & slotMask; slots[i]; i = (i + 1) & slotMask) {
+            ConfigParameter& param = first->items[slots[i] - 1];
+            if (param.hasKey(key)) return &param;
+        }
+        return nullptr;
+    }
+    // Parameters added or renamed since compact()
+    for (Block* block = first; block; block = block->next) {
+        for (uint16_t i = 0; i < block->count; i++) {
+            if (block->items[i].hasKey(key)) return &block->items[i];
+        }
+    }
+    return nullptr;
+}
+
+ConfigParameter* WebConfigRegistry::at(size_t index) {
+    if (first == last) return first && index < first->count ? &first->items[index] : nullptr;
+    for (Block* block = first; block; block = block->next) {
+        if (index < block->count) return &block->items[index];
+        index -= block->count;
+    }
+    return nullptr;
+}
+
+// ===== DESCRIPTORS =====
+
+ConfigParameterDescriptor* WebConfigRegistry::edit(ConfigParameter& param) {
+    if (!(param.flags & WEBCONFIG_PARAM_OWNED)) {
+        ConfigParameterDescriptor* copy = createDescriptor();
+        if (!copy) return nullptr;
+        *copy = param.meta();
+        param.descriptor = copy;
+        param.flags |= WEBCONFIG_PARAM_OWNED;
+    }
+    return const_cast<ConfigParameterDescriptor*>(param.descriptor);
+}
+
+void WebConfigRegistry::setString(ConfigParameter& param, DescriptorString field, const String& value) {
+    ConfigParameterDescriptor* descriptor = edit(param);
+    if (!descriptor) return;
+    // The previous string stays in the arena until the next compact()
+    descriptor->*DESC_STRINGS[field] = arena.copy(value.c_str());
+    compacted = false;
+    if (field == DESC_KEY) slots = nullptr;
+}
+
+// ===== COMPACTION =====
+
+bool WebConfigRegistry::compact() {
+    if (compacted) return true;
+    if (count == 0) {
+        arena.release();
+        first = last = nullptr;
+        slots = nullptr;
+        compacted = true;
+        return true;
+    }
+
+    // Exact size of the live data, plus worst-case padding per aligned section
+    size_t bytes = sizeof(Block) + alignof(Block)
+                 + count * sizeof(ConfigParameter) + alignof(ConfigParameter);
+    size_t owned = 0;
+    for (iterator it = begin(); it != end(); ++it) {
+        if (!(it->flags & WEBCONFIG_PARAM_OWNED)) continue;
+        owned++;
+        for (uint8_t field = 0; field < DESC_STRING_COUNT; field++) {
+            const char* text = it->descriptor->*DESC_STRINGS[field];
+            if (arena.owns(text)) bytes += strlen(text) + 1;
+        }
+    }
+    if (owned) bytes += owned * sizeof(ConfigParameterDescriptor) + alignof(ConfigParameterDescriptor);
+
+    // Index at most half full, so a miss ends after a few probes
+    size_t slotCount = 8;
+    while (slotCount < count * 2) slotCount <<= 1;
+    bytes += slotCount * sizeof(uint16_t) + alignof(uint16_t);
+
+    WebConfigArena frozen(bytes);
+    Block* block = (Block*)frozen.allocate(sizeof(Block), alignof(Block));
+    ConfigParameter* items = block ? (ConfigParameter*)frozen.allocate(count * sizeof(ConfigParameter), alignof(ConfigParameter)) : nullptr;
+    uint16_t* index = items ? (uint16_t*)frozen.allocate(slotCount * sizeof(uint16_t), alignof(uint16_t)) : nullptr;
+    // Descriptors as one array ahead of the strings, so only the array needs padding
+    ConfigParameterDescriptor* descriptors = index && owned ? (ConfigParameterDescriptor*)
+        frozen.allocate(owned * sizeof(ConfigParameterDescriptor), alignof(ConfigParameterDescriptor)) : nullptr;
+    if (!index || (owned && !descriptors)) {
+        WC_LOGW("WebConfigRegistry: Not enough memory to compact %u bytes", (unsigned)bytes);
+        return false;
+    }
+
+    // The single chunk has room for the rest, these allocations cannot fail
+    memset(index, 0, slotCount * sizeof(uint16_t));
+    size_t position = 0;
+    for (iterator it = begin(); it != end(); ++it, ++position) {
+        ConfigParameter* param = new (&items[position]) ConfigParameter(std::move(*it));
+        if (!(param->flags & WEBCONFIG_PARAM_OWNED)) continue;
+        ConfigParameterDescriptor* descriptor = descriptors++;
+        *descriptor = *param->descriptor;
+        for (uint8_t field = 0; field < DESC_STRING_COUNT; field++) {
+            const char*& text = descriptor->*DESC_STRINGS[field];
+            if (arena.owns(text)) text = frozen.copy(text);
+        }
+        param->descriptor = descriptor;
+    }
+
+    destroyRecords();
+    arena.swap(frozen);
+    block->next = nullptr;
+    block->items = items;
+    block->count = count;
+    block->capacity = count;
+    first = last = block;
+
+    // Keys are read from the new descriptors, which may be in flash
+    for (size_t i = 0; i < count; i++) {
+        const char* key = items[i].getKeyData();
+        if (!key) continue;
+        uint32_t slot = keyHash(key) & (slotCount - 1);
+        while (index[slot]) slot = (slot + 1) & (slotCount - 1);
+        index[slot] = (uint16_t)(i + 1);
+    }
+    slots = index;
+    slotMask = slotCount - 1;
+    compacted = true;
+    WC_LOGD("WebConfigRegistry: %u parameters compacted into %u bytes", (unsigned)count, (unsigned)bytes);
+    return true;
+}
@@ -0,0 +1,250 @@
+/*
+ * ESP32WebConfig Library - Parameter Registry
+ * Parameter records and their metadata, kept in one bump arena
+ *
+ * Records are allocated in blocks from a WebConfigArena, together with the
+ * descriptors and strings of parameters registered at runtime. Each block
+ * doubles the capacity and reserves arena room for its records and their
+ * runtime metadata, so registration takes a few allocations per doubling
+ * rather than one per parameter; reserve() with the final count takes one.
+ * Nothing is reallocated while parameters are added, so record pointers
+ * stay valid. compact(), called from begin() once the schema is complete,
+ * moves all of it into a single allocation of the exact size, frees the
+ * chunks used during registration and builds a key hash index; afterwards
+ * the records are one contiguous array, at() is an array access and find()
+ * one hash probe. Descriptor tables passed to addParameters() are
+ * referenced, not copied.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGREGISTRY_H
+#define WEBCONFIGREGISTRY_H
+
+#include "WebConfigPlatform.h"
+#include "WebConfigArena.h"
+
+// Records per block while registering
+#ifndef WEBCONFIG_PARAM_BLOCK
+#define WEBCONFIG_PARAM_BLOCK 8
+#endif
+
+// Arena bytes reserved per runtime parameter for its key, label and default;
+// longer strings still fit, in extra arena chunks
+#ifndef WEBCONFIG_PARAM_TEXT_BYTES
+#define WEBCONFIG_PARAM_TEXT_BYTES 48
+#endif
+
+// Supported parameter data types
+enum ParameterType {
+    PARAM_TEXT,         // Text input
+    PARAM_PASSWORD,     // Password input (hidden)
+    PARAM_NUMBER,       // Number input
+    PARAM_FLOAT,        // Float input
+    PARAM_CHECKBOX,     // Checkbox (true/false)
+    PARAM_SELECT,       // Select dropdown
+    PARAM_TEXTAREA,     // Larger text area
+    PARAM_COLOR,        // Color picker
+    PARAM_RANGE,        // Range slider
+    PARAM_EMAIL,        // Email input
+    PARAM_URL,          // URL input
+    PARAM_TIME,         // Time input
+    PARAM_DATE          // Date input
+};
+
+// Static parameter metadata for addParameters(). Declare tables const so
+// they stay in flash (on ESP8266 add PROGMEM, and PROGMEM strings to move
+// the text out of RAM too). Trailing fields may be omitted: strings then
+// read as empty, step 0 as 1 and group as "general". NUMBER and RANGE
+// values are always checked against [minValue, maxValue], so give those
+// types their bounds; FLOAT values only when floatBounds is set.
+struct ConfigParameterDescriptor {
+    const char* key;               // Parameter key
+    const char* label;             // UI label
+    ParameterType type;            // Parameter type
+    const char* defaultValue;      // Default value
+    int minValue;                  // Min value for NUMBER/RANGE
+    int maxValue;                  // Max value for NUMBER/RANGE
+    int step;                      // Step for NUMBER/RANGE
+    const char* group;             // Parameter group
+    const char* description;       // Description/help text
+    const char* validation;        // Regex validation
+    const char* options;           // Options for SELECT (JSON array)
+    const char* attributes;        // Additional HTML attributes
+    bool required;                 // Required parameter
+    bool readOnly;                 // Read-only parameter
+    float minFloat;                // Min value for FLOAT when floatBounds is set
+    float maxFloat;                // Max value for FLOAT when floatBounds is set
+    bool floatBounds;              // Check FLOAT values against [minFloat, maxFloat]
+};
+
+// ConfigParameter::flags
+#define WEBCONFIG_PARAM_OWNED    0x01   // Descriptor lives in the registry arena
+#define WEBCONFIG_PARAM_READONLY 0x02
+
+// Descriptor string fields, for WebConfigRegistry::setString()
+enum DescriptorString {
+    DESC_KEY,
+    DESC_LABEL,
+    DESC_DEFAULT,
+    DESC_GROUP,
+    DESC_DESCRIPTION,
+    DESC_VALIDATION,
+    DESC_OPTIONS,
+    DESC_ATTRIBUTES,
+    DESC_STRING_COUNT
+};
+
+// Type of the variable a parameter is bound to
+enum WebConfigBindType {
+    BIND_NONE,
+    BIND_INT,                      // int
+    BIND_FLOAT,                    // float
+    BIND_BOOL,                     // bool
+    BIND_STRING                    // String
+};
+
+// Structure for storing parameters: the value and flags in RAM, the rest
+// behind the descriptor pointer
+struct ConfigParameter {
+    const ConfigParameterDescriptor* descriptor;   // Static metadata
+    String value;                  // Current value
+    void* binding;                 // Variable kept in sync with value, or nullptr
+    union {                        // value parsed by getType(), see parseValue()
+        int intValue;
+        float floatValue;
+        bool boolValue;
+    } parsed;
+    int16_t order;                 // Display order
+    uint8_t flags;                 // WEBCONFIG_PARAM_* bits
+    uint8_t bindType;              // WebConfigBindType of binding
+
+    // RAM copy of the descriptor, valid for PROGMEM tables too
+    ConfigParameterDescriptor meta() const;
+    bool hasKey(const char* key) const;
+    String getKey() const;
+    // Key as stored in the descriptor, a flash pointer on ESP8266
+    const char* getKeyData() const;
+    String getDefaultValue() const;
+    ParameterType getType() const;
+    bool isReadOnly() const { return flags & WEBCONFIG_PARAM_READONLY; }
+
+    // Call after every change of value: refreshes parsed and the bound variable
+    void parseValue();
+    
+    // Whether the application changed the bound variable since value was
+    // last set; readString() then returns the variable's value
+    bool bindingChanged() const { return binding && !bindingMatches(); }
+
+    // Current value for the getters: the bound variable when the application
+    // changed it, otherwise value. The record itself is left as it is.
+    int readInt() const;
+    float readFloat() const;
+    bool readBool() const;
+    String readString() const;
+
+private:
+    bool bindingMatches() const;
+    String formatBinding() const;
+};
+
+// Typed reference to a parameter, returned by the typed add functions.
+// Only the index is stored; T selects the ESP32WebConfig::get/set overload.
+#define WEBCONFIG_INVALID_HANDLE 0xFFFF
+
+template <typename T>
+struct ParamHandle {
+    uint16_t index;
+
+    bool isValid() const { return index != WEBCONFIG_INVALID_HANDLE; }
+};
+
+
+class WebConfigRegistry {
+private:
+    struct Block {
+        Block* next;
+        ConfigParameter* items;
+        uint16_t count;
+        uint16_t capacity;
+    };
+
+public:
+    // Walks the records in registration order
+    class iterator {
+    public:
+        iterator(Block* block, uint16_t index) : block(block), index(index) {}
+        ConfigParameter& operator*() const { return block->items[index]; }
+        ConfigParameter* operator->() const { return &block->items[index]; }
+        iterator& operator++() {
+            if (++index >= block->count) {
+                block = skipEmpty(block->next);
+                index = 0;
+            }
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return block != other.block || index != other.index; }
+        bool operator==(const iterator& other) const { return !(*this != other); }
+    private:
+        Block* block;
+        uint16_t index;
+    };
+
+    WebConfigRegistry();
+    ~WebConfigRegistry();
+
+    // Descriptor for a runtime parameter, zeroed and owned by the registry
+    ConfigParameterDescriptor* createDescriptor();
+
+    // Appends a record for descriptor, value set to its default.
+    // Returns nullptr when out of memory.
+    ConfigParameter* add(const ConfigParameterDescriptor* descriptor, uint8_t flags = 0);
+
+    // Makes room for count more records in one block; owned also reserves
+    // arena room for their runtime descriptors and strings
+    void reserve(size_t count, bool owned = false);
+
+    ConfigParameter* find(const char* key);
+    ConfigParameter* at(size_t index);
+    size_t size() const { return count; }
+
+    // Descriptor of param made writable; descriptors from const tables are copied first
+    ConfigParameterDescriptor* edit(ConfigParameter& param);
+
+    // Replaces a descriptor string with an arena copy of value, nullptr when empty
+    void setString(ConfigParameter& param, DescriptorString field, const String& value);
+
+    // Moves records, owned descriptors and strings into one exact-size
+    // allocation. Returns false when it could not be allocated, in which
+    // case the registry is left as it was.
+    bool compact();
+    bool isCompact() const { return compacted; }
+
+    // Heap held by the arena
+    size_t getBytes() const { return arena.getCapacity(); }
+
+    iterator begin() { return iterator(skipEmpty(first), 0); }
+    iterator end() { return iterator(nullptr, 0); }
+
+private:
+    WebConfigArena arena;
+    Block* first;
+    Block* last;
+    size_t count;
+    bool compacted;
+    uint16_t* slots;        // Key hash index built by compact(): record index + 1, 0 when empty
+    uint32_t slotMask;
+
+    static Block* skipEmpty(Block* block) {
+        while (block && block->count == 0) block = block->next;
+        return block;
+    }
+    Block* addBlock(size_t capacity, bool owned);
+    void destroyRecords();
+
+    WebConfigRegistry(const WebConfigRegistry&);
+    WebConfigRegistry& operator=(const WebConfigRegistry&);
+};
+
+#endif // WEBCONFIGREGISTRY_H
@@ -0,0 +1,161 @@
+/*
+ * ESP32WebConfig Library - Request Router Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigRouter.h"
+
+typedef WebConfigRouter::Route Route;
+typedef WebConfigRouter::PrefixRoute PrefixRoute;
+
+#define ROUTE(path, methods, handler, metric) { webConfigHash(path, WEBCONFIG_ROUTE_SEED), path, methods, handler, metric }
+#define PREFIX_ROUTE(prefix, methods, handler, metric) { prefix, sizeof(prefix) - 1, methods, handler, metric }
+
+// Compile-time check that no two routes share a slot
+constexpr bool routeSlotFree(const Route* r, size_t n, size_t i, size_t j) {
+    return j >= n || (webConfigRouteSlot(r[i].hash) != webConfigRouteSlot(r[j].hash) && routeSlotFree(r, n, i, j + 1));
+}
+
+constexpr bool routeSlotsDistinct(const Route* r, size_t n, size_t i = 0) {
+    return i >= n || (routeSlotFree(r, n, i, i + 1) && routeSlotsDistinct(r, n, i + 1));
+}
+
+const Route* WebConfigRouter::routes(size_t& count) {
+    static constexpr Route table[] = {
+        #if WEBCONFIG_ENABLE_CAPTIVE_DNS
+        // OS connectivity probes, answered before any authentication or rendering
+        ROUTE("/generate_204",              ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Android, ChromeOS
+        ROUTE("/gen_204",                   ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Android
+        ROUTE("/hotspot-detect.html",       ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // iOS, macOS
+        ROUTE("/library/test/success.html", ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Older iOS
+        ROUTE("/connecttest.txt",           ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Windows 10+
+        ROUTE("/ncsi.txt",                  ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Windows 7/8
+        ROUTE("/redirect",                  ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Windows
+        ROUTE("/success.txt",               ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Firefox
+        ROUTE("/canonical.html",            ROUTE_ANY, &ESP32WebConfig::handleCaptiveProbe, METRIC_CAPTIVE_PROBE),  // Firefox
+        #endif
+
+        #if WEBCONFIG_ENABLE_PAGES
+        // Pages
+        ROUTE("/",          ROUTE_ANY,  &ESP32WebConfig::handleRoot, METRIC_ROOT),
+        ROUTE("/config",    ROUTE_ANY,  &ESP32WebConfig::handleConfig, METRIC_CONFIG),
+        ROUTE("/network",   ROUTE_ANY,  &ESP32WebConfig::handleNetwork, METRIC_NETWORK),
+        ROUTE("/advanced",  ROUTE_ANY,  &ESP32WebConfig::handleAdvanced, METRIC_ADVANCED),
+        ROUTE("/backup",    ROUTE_ANY,  &ESP32WebConfig::handleBackup, METRIC_BACKUP),
+        #endif
+
+        // Actions and API
+        ROUTE("/save",       ROUTE_POST, &ESP32WebConfig::handleSave, METRIC_SAVE_FORM),
+        ROUTE("/get",        ROUTE_ANY,  &ESP32WebConfig::handleGet, METRIC_GET),
+        ROUTE("/set",        ROUTE_POST, &ESP32WebConfig::handleSet, METRIC_SET),
+        ROUTE("/reset",      ROUTE_ANY,  &ESP32WebConfig::handleReset, METRIC_RESET),
+        ROUTE("/reboot",     ROUTE_ANY,  &ESP32WebConfig::handleReboot, METRIC_REBOOT),
+        #if WEBCONFIG_ENABLE_JSON
+        ROUTE("/export",     ROUTE_ANY,  &ESP32WebConfig::handleExport, METRIC_EXPORT),
+        ROUTE("/import",     ROUTE_POST, &ESP32WebConfig::handleImport, METRIC_IMPORT),
+        #endif
+        ROUTE("/api/status", ROUTE_ANY,  &ESP32WebConfig::handleStatus, METRIC_STATUS),
+        ROUTE("/api/metrics", ROUTE_GET, &ESP32WebConfig::handleMetrics, METRIC_METRICS),
+        ROUTE("/api/log",    ROUTE_GET,  &ESP32WebConfig::handleLog, METRIC_LOG),
+        ROUTE("/api/trace",  ROUTE_GET,  &ESP32WebConfig::handleTrace, METRIC_TRACE),
+        ROUTE("/api/config", ROUTE_GET,  &ESP32WebConfig::handleGet, METRIC_GET)
+    };
+    static_assert(routeSlotsDistinct(table, sizeof(table) / sizeof(table[0])),
+                  "Route hash collision, change WEBCONFIG_ROUTE_SEED");
+
+    count = sizeof(table) / sizeof(table[0]);
+    return table;
+}
+
+const PrefixRoute* WebConfigRouter::prefixRoutes(size_t& count) {
+    static constexpr PrefixRoute table[] = {
+        PREFIX_ROUTE("/api/config/", ROUTE_GET | ROUTE_POST | ROUTE_PUT, &ESP32WebConfig::handleConfigValue, METRIC_CONFIG_VALUE)
+    };
+
+    count = sizeof(table) / sizeof(table[0]);
+    return table;
+}
+
+WebConfigRouter::WebConfigRouter(ESP32WebConfig* config) : config(config) {
+    matchedRoute = nullptr;
+    matchedPrefix = nullptr;
+    memset(slots, 0, sizeof(slots));
+
+    size_t count;
+    const Route* table = routes(count);
+    for (size_t i = 0; i < count; i++) {
+        slots[webConfigRouteSlot(table[i].hash)] = i + 1;
+    }
+}
+
+uint8_t WebConfigRouter::methodFlag(HTTPMethod method) {
+    switch (method) {
+        case HTTP_GET:    return ROUTE_GET;
+        case HTTP_POST:   return ROUTE_POST;
+        case HTTP_PUT:    return ROUTE_PUT;
+        case HTTP_DELETE: return ROUTE_DELETE;
+        default:          return ROUTE_OTHER;
+    }
+}
+
+bool WebConfigRouter::match(HTTPMethod method, const char* uri) {
+    matchedRoute = nullptr;
+    matchedPrefix = nullptr;
+    uint8_t flag = methodFlag(method);
+
+    // Exact routes: one hash, one slot, one string compare
+    size_t count;
+    const Route* table = routes(count);
+    uint32_t hash = webConfigHash(uri, WEBCONFIG_ROUTE_SEED);
+    uint8_t index = slots[webConfigRouteSlot(hash)];
+    if (index) {
+        const Route& route = table[index - 1];
+        if (route.hash == hash && (route.methods & flag) && strcmp(route.path, uri) == 0) {
+            matchedRoute = &route;
+            return true;
+        }
+    }
+
+    // Parameterized routes
+    const PrefixRoute* prefixes = prefixRoutes(count);
+    for (size_t i = 0; i < count; i++) {
+        if ((prefixes[i].methods & flag) && strncmp(uri, prefixes[i].prefix, prefixes[i].length) == 0 &&
+            uri[prefixes[i].length] != '\0') {
+            matchedPrefix = &prefixes[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WebConfigRouter::canHandle(HTTPMethod method, WEBCONFIG_URI_ARG uri) {
+    return match(method, uri.c_str());
+}
+
+bool WebConfigRouter::handle(WebServer& server, HTTPMethod method, WEBCONFIG_URI_ARG uri) {
+    (void)server;
+
+    // WebServer calls canHandle() right before handle() with the same request
+    if (!matchedRoute && !matchedPrefix && !match(method, uri.c_str())) {
+        return false;
+    }
+
+    WebConfigMetricId metric = matchedRoute ? matchedRoute->metric : matchedPrefix->metric;
+    WebConfigMetrics::Scope scope(config->metrics, metric);
+    WC_TRACE_SCOPE(metric);
+    config->requestsServed++;
+    if (matchedRoute) {
+        (config->*matchedRoute->handler)();
+    } else {
+        // Parameter points into the request URI, no splitting or copies
+        (config->*matchedPrefix->handler)(uri.c_str() + matchedPrefix->length);
+    }
+    // Handler temporaries live until the response is sent
+    config->requestArena.reset();
+
+    matchedRoute = nullptr;
+    matchedPrefix = nullptr;
+    return true;
+}
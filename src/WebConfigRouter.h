@@ -0,0 +1,79 @@
+/*
+ * ESP32WebConfig Library - Request Router
+ * Single RequestHandler that dispatches all library routes through a
+ * perfect-hash table checked at compile time
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGROUTER_H
+#define WEBCONFIGROUTER_H
+
+#include "ESP32WebConfig.h"
+#include "WebConfigHash.h"
+
+// RequestHandler takes the URI by value on ESP32 cores before 3.0
+#if defined(ESP8266) || (defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3)
+  #define WEBCONFIG_URI_ARG const String&
+#else
+  #define WEBCONFIG_URI_ARG String
+#endif
+
+// Route table size (power of two) and hash seed; if the static_assert in
+// WebConfigRouter.cpp fires after adding a route, pick another seed
+#define WEBCONFIG_ROUTE_SLOTS 64
+#define WEBCONFIG_ROUTE_SEED 0x811CA064
+
+// Allowed request methods per route
+#define ROUTE_GET    0x01
+#define ROUTE_POST   0x02
+#define ROUTE_PUT    0x04
+#define ROUTE_DELETE 0x08
+#define ROUTE_OTHER  0x10
+#define ROUTE_ANY    0xFF
+
+constexpr uint8_t webConfigRouteSlot(uint32_t hash) {
+    return (hash ^ (hash >> 16)) & (WEBCONFIG_ROUTE_SLOTS - 1);
+}
+
+class WebConfigRouter : public RequestHandler {
+public:
+    typedef void (ESP32WebConfig::*Handler)();
+    typedef void (ESP32WebConfig::*ParamHandler)(const char* param);
+
+    struct Route {
+        uint32_t hash;
+        const char* path;
+        uint8_t methods;
+        Handler handler;
+        WebConfigMetricId metric;
+    };
+
+    // Parameterized route: everything after prefix is passed to the handler
+    struct PrefixRoute {
+        const char* prefix;
+        uint8_t length;
+        uint8_t methods;
+        ParamHandler handler;
+        WebConfigMetricId metric;
+    };
+
+    explicit WebConfigRouter(ESP32WebConfig* config);
+
+    bool canHandle(HTTPMethod method, WEBCONFIG_URI_ARG uri) override;
+    bool handle(WebServer& server, HTTPMethod method, WEBCONFIG_URI_ARG uri) override;
+
+private:
+    ESP32WebConfig* config;
+    uint8_t slots[WEBCONFIG_ROUTE_SLOTS];   // Route index + 1, 0 = empty
+    const Route* matchedRoute;
+    const PrefixRoute* matchedPrefix;
+
+    static const Route* routes(size_t& count);
+    static const PrefixRoute* prefixRoutes(size_t& count);
+    static uint8_t methodFlag(HTTPMethod method);
+    bool match(HTTPMethod method, const char* uri);
+};
+
+#endif // WEBCONFIGROUTER_H
@@ -0,0 +1,256 @@
+/*
+ * ESP32WebConfig Library - Compile-Time Schema
+ * Parameters declared once as a list, with typed storage, accessors,
+ * bounds checks and key lookup generated at compile time
+ *
+ *   #define SENSOR_PARAMS(P) \
+ *       P(int,    interval, "Interval (s)", 60,          1,   3600) \
+ *       P(float,  offset,   "Offset",       0.5,         -10, 10)   \
+ *       P(bool,   enabled,  "Enabled",      true,        0,   0)    \
+ *       P(String, topic,    "MQTT topic",   "sensors/x", 0,   0)
+ *   WEBCONFIG_SCHEMA(SensorConfig, SENSOR_PARAMS)
+ *
+ *   SensorConfig sensor;
+ *   sensor.registerWith(config);     // before config.begin()
+ *   int seconds = sensor.interval(); // plain member load
+ *   sensor.interval(120);            // bounds-checked, updates config too
+ *   config.get(sensor.handle<int>(SensorConfig::Id::interval));
+ *
+ * Each entry is P(type, name, label, default, min, max); type is int,
+ * float, bool or String, and min/max are ignored for bool and String. A
+ * numeric default outside its bounds does not compile. Parameters are
+ * C++ names, so a misspelt key is a compile error instead of a silent 0.
+ * Names must not clash with the members below (get, handle, indexOf, ...).
+ *
+ * Keys arriving as strings, e.g. from HTTP, are resolved by indexOf()
+ * through a perfect hash; a static_assert rejects colliding keys, in which
+ * case define another WEBCONFIG_SCHEMA_SEED before the schema.
+ *
+ * registerWith() adds the parameters to ESP32WebConfig from a generated
+ * const descriptor table and binds them to the schema storage, so the web
+ * pages, the API, import and EEPROM loading all update the typed values.
+ * Values set before registerWith() are replaced by the defaults.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGSCHEMA_H
+#define WEBCONFIGSCHEMA_H
+
+#include "ESP32WebConfig.h"
+#include "WebConfigHash.h"
+#include <string.h>
+
+#ifndef WEBCONFIG_SCHEMA_SEED
+#define WEBCONFIG_SCHEMA_SEED 0x811CA064
+#endif
+
+// ===== TYPE MAPPING =====
+
+template <typename T> struct WebConfigSchemaType;
+
+template <> struct WebConfigSchemaType<int> {
+    typedef int Value;
+    typedef int Arg;
+    static constexpr ParameterType param() { return PARAM_NUMBER; }
+    static constexpr WebConfigBindType bind() { return BIND_INT; }
+    static constexpr const char* text(const char* stringized, int) { return stringized; }
+    static constexpr int bound(double limit) { return (int)limit; }
+    static constexpr float floatBound(double) { return 0; }
+    static constexpr bool floatBounds() { return false; }
+    static constexpr const char* attributes(const char*) { return nullptr; }
+    static constexpr bool valid(double value, double min, double max) { return value >= min && value <= max; }
+    static int parse(const String& value) { return value.toInt(); }
+    static String toString(int value) { return String(value); }
+};
+
+// Float bounds go to the float range of the descriptor, checked on every
+// write, and to the HTML attributes
+template <> struct WebConfigSchemaType<float> {
+    typedef float Value;
+    typedef float Arg;
+    static constexpr ParameterType param() { return PARAM_FLOAT; }
+    static constexpr WebConfigBindType bind() { return BIND_FLOAT; }
+    static constexpr const char* text(const char* stringized, double) { return stringized; }
+    static constexpr int bound(double) { return 0; }
+    static constexpr float floatBound(double limit) { return (float)limit; }
+    static constexpr bool floatBounds() { return true; }
+    static constexpr const char* attributes(const char* range) { return range; }
+    static constexpr bool valid(double value, double min, double max) { return value >= min && value <= max; }
+    static float parse(const String& value) { return value.toFloat(); }
+    static String toString(float value) { return String(value, 6); }
+};
+
+template <> struct WebConfigSchemaType<bool> {
+    typedef bool Value;
+    typedef bool Arg;
+    static constexpr ParameterType param() { return PARAM_CHECKBOX; }
+    static constexpr WebConfigBindType bind() { return BIND_BOOL; }
+    static constexpr const char* text(const char* stringized, bool) { return stringized; }
+    static constexpr int bound(double) { return 0; }
+    static constexpr float floatBound(double) { return 0; }
+    static constexpr bool floatBounds() { return false; }
+    static constexpr const char* attributes(const char*) { return nullptr; }
+    static constexpr bool valid(bool, double, double) { return true; }
+    static bool parse(const String& value) { return value == "true" || value == "1" || value == "on"; }
+    static String toString(bool value) { return value ? "true" : "false"; }
+};
+
+template <> struct WebConfigSchemaType<String> {
+    typedef String Value;
+    typedef const String& Arg;
+    static constexpr ParameterType param() { return PARAM_TEXT; }
+    static constexpr WebConfigBindType bind() { return BIND_STRING; }
+    static constexpr const char* text(const char*, const char* value) { return value; }
+    static constexpr int bound(double) { return 0; }
+    static constexpr float floatBound(double) { return 0; }
+    static constexpr bool floatBounds() { return false; }
+    static constexpr const char* attributes(const char*) { return nullptr; }
+    static constexpr bool valid(const char*, double, double) { return true; }
+    static bool valid(const String&, double, double) { return true; }
+    static const String& parse(const String& value) { return value; }
+    static const String& toString(const String& value) { return value; }
+};
+
+// ===== PERFECT HASH =====
+
+constexpr uint8_t webConfigSchemaSlot(uint32_t hash, uint32_t mask) {
+    return (hash ^ (hash >> 16)) & mask;
+}
+
+// Smallest power of two, at least 4, holding count keys at half load
+constexpr uint32_t webConfigSchemaSlots(uint32_t count, uint32_t slots = 4) {
+    return slots >= count * 2 ? slots : webConfigSchemaSlots(count, slots * 2);
+}
+
+constexpr bool webConfigSchemaUnique(uint32_t, uint32_t) {
+    return true;
+}
+
+template <typename... Rest>
+constexpr bool webConfigSchemaUnique(uint32_t mask, uint32_t hash, uint32_t other, Rest... rest) {
+    return webConfigSchemaSlot(hash, mask) != webConfigSchemaSlot(other, mask) &&
+           webConfigSchemaUnique(mask, hash, rest...);
+}
+
+constexpr bool webConfigSchemaDistinct(uint32_t) {
+    return true;
+}
+
+template <typename... Rest>
+constexpr bool webConfigSchemaDistinct(uint32_t mask, uint32_t hash, Rest... rest) {
+    return webConfigSchemaUnique(mask, hash, rest...) && webConfigSchemaDistinct(mask, rest...);
+}
+
+// ===== GENERATORS =====
+
+#define WC_SCHEMA_ID(type, name, label, def, min, max) name,
+#define WC_SCHEMA_FIELD(type, name, label, def, min, max) WebConfigSchemaType<type>::Value name;
+#define WC_SCHEMA_INIT(type, name, label, def, min, max) schemaValues.name = def;
+#define WC_SCHEMA_HASH(type, name, label, def, min, max) , webConfigHash(#name, WEBCONFIG_SCHEMA_SEED)
+#define WC_SCHEMA_BIND(type, name, label, def, min, max) \
+    config.bindParameter(#name, &schemaValues.name, WebConfigSchemaType<type>::bind());
+#define WC_SCHEMA_CHECK(type, name, label, def, min, max) \
+    static_assert(WebConfigSchemaType<type>::valid(def, min, max), "Default of " #name " is outside its bounds");
+
+#define WC_SCHEMA_DESCRIPTOR(type, name, label, def, min, max) \
+    { #name, label, WebConfigSchemaType<type>::param(), WebConfigSchemaType<type>::text(#def, def), \
+      WebConfigSchemaType<type>::bound(min), WebConfigSchemaType<type>::bound(max), 0, \
+      nullptr, nullptr, nullptr, nullptr, \
+      WebConfigSchemaType<type>::attributes("min='" #min "' max='" #max "' step='any'"), false, false, \
+      WebConfigSchemaType<type>::floatBound(min), WebConfigSchemaType<type>::floatBound(max), \
+      WebConfigSchemaType<type>::floatBounds() },
+
+#define WC_SCHEMA_ACCESSORS(type, name, label, def, min, max) \
+    WebConfigSchemaType<type>::Arg name() const { return schemaValues.name; } \
+    bool name(WebConfigSchemaType<type>::Arg value) { \
+        if (!WebConfigSchemaType<type>::valid(value, min, max)) return false; \
+        if (schemaOwner && !schemaOwner->set(handle<type>(Id::name), value)) return false; \
+        schemaValues.name = value; \
+        return true; \
+    }
+
+#define WC_SCHEMA_SET_CASE(type, name, label, def, min, max) \
+    case Id::name: return name(WebConfigSchemaType<type>::parse(value));
+#define WC_SCHEMA_GET_CASE(type, name, label, def, min, max) \
+    case Id::name: return WebConfigSchemaType<type>::toString(schemaValues.name);
+
+// ===== SCHEMA =====
+
+#define WEBCONFIG_SCHEMA(Name, LIST) \
+class Name { \
+public: \
+    struct Id { enum : uint8_t { LIST(WC_SCHEMA_ID) COUNT }; }; \
+    enum : uint8_t { COUNT = Id::COUNT }; \
+    enum : uint32_t { SEED = WEBCONFIG_SCHEMA_SEED, SLOTS = webConfigSchemaSlots(COUNT) }; \
+    \
+    /* Storage, one typed member per parameter */ \
+    struct Values { LIST(WC_SCHEMA_FIELD) }; \
+    \
+    Name() : schemaOwner(nullptr), schemaBase(0) { \
+        LIST(WC_SCHEMA_INIT) \
+        memset(schemaSlots, 0, sizeof(schemaSlots)); \
+        for (uint8_t i = 0; i < COUNT; i++) { \
+            schemaSlots[webConfigSchemaSlot(webConfigHash(key(i), SEED), SLOTS - 1)] = i + 1; \
+        } \
+    } \
+    \
+    /* Typed accessors: name() reads, name(value) checks bounds and writes */ \
+    LIST(WC_SCHEMA_ACCESSORS) \
+    const Values& get() const { return schemaValues; } \
+    \
+    /* Adds the parameters to config and binds them to this schema */ \
+    void registerWith(ESP32WebConfig& config) { \
+        schemaOwner = &config; \
+        schemaBase = config.getParameterCount(); \
+        config.addParameters(descriptors(), COUNT); \
+        LIST(WC_SCHEMA_BIND) \
+    } \
+    \
+    /* String keys, e.g. from HTTP; -1 when key is not in the schema */ \
+    int indexOf(const char* key) const { \
+        if (!key) return -1; \
+        uint8_t entry = schemaSlots[webConfigSchemaSlot(webConfigHash(key, SEED), SLOTS - 1)]; \
+        return entry && strcmp_P(key, Name::key(entry - 1)) == 0 ? entry - 1 : -1; \
+    } \
+    bool setValue(const char* key, const String& value) { \
+        switch (indexOf(key)) { \
+            LIST(WC_SCHEMA_SET_CASE) \
+            default: return false; \
+        } \
+    } \
+    String getValue(const char* key) const { \
+        switch (indexOf(key)) { \
+            LIST(WC_SCHEMA_GET_CASE) \
+            default: return String(); \
+        } \
+    } \
+    \
+    /* Handle of a parameter in the ESP32WebConfig passed to registerWith() */ \
+    template <typename T> ParamHandle<T> handle(uint8_t id) const { \
+        ParamHandle<T> h = { (uint16_t)(schemaOwner ? schemaBase + id : WEBCONFIG_INVALID_HANDLE) }; \
+        return h; \
+    } \
+    \
+    static const char* key(uint8_t id) { \
+        return (const char*)pgm_read_ptr(&descriptors()[id].key); \
+    } \
+    static const ConfigParameterDescriptor* descriptors() { \
+        static const ConfigParameterDescriptor table[] PROGMEM = { LIST(WC_SCHEMA_DESCRIPTOR) }; \
+        return table; \
+    } \
+    \
+private: \
+    Values schemaValues; \
+    ESP32WebConfig* schemaOwner; \
+    uint16_t schemaBase; \
+    uint8_t schemaSlots[SLOTS]; \
+    \
+    static_assert(COUNT > 0, "Empty schema"); \
+    static_assert(webConfigSchemaDistinct(SLOTS - 1 LIST(WC_SCHEMA_HASH)), \
+                  "Schema key hash collision, define another WEBCONFIG_SCHEMA_SEED"); \
+    LIST(WC_SCHEMA_CHECK) \
+}
+
+#endif // WEBCONFIGSCHEMA_H
@@ -0,0 +1,267 @@
+/*
+ * ESP32WebConfig Library - Session Tokens Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigFeatures.h"
+
+#if WEBCONFIG_ENABLE_AUTH
+
+#include "WebConfigSession.h"
+
+// ===== SHA-256 PRIMITIVES =====
+
+#if defined(WEBCONFIG_HOST)
+// FIPS 180-4 SHA-256; only the host build uses it, the cores bring their own
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+static void sha256Compress(WebConfigSha256Context* ctx) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)ctx->block[i * 4] << 24) | ((uint32_t)ctx->block[i * 4 + 1] << 16) |
+               ((uint32_t)ctx->block[i * 4 + 2] << 8) | ctx->block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t v[8];
+    memcpy(v, ctx->state, sizeof(v));
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = v[7] + (rotr(v[4], 6) ^ rotr(v[4], 11) ^ rotr(v[4], 25)) +
+                      ((v[4] & v[5]) ^ (~v[4] & v[6])) + SHA256_K[i] + w[i];
+        uint32_t t2 = (rotr(v[0], 2) ^ rotr(v[0], 13) ^ rotr(v[0], 22)) +
+                      ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        memmove(v + 1, v, 7 * sizeof(uint32_t));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++) ctx->state[i] += v[i];
+}
+
+static void hashInit(WebConfigSha256Context* ctx) {
+    static const uint32_t initial[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(ctx->state, initial, sizeof(initial));
+    ctx->length = 0;
+}
+static void hashUpdate(WebConfigSha256Context* ctx, const uint8_t* data, size_t len) {
+    while (len--) {
+        ctx->block[ctx->length++ % 64] = *data++;
+        if (ctx->length % 64 == 0) sha256Compress(ctx);
+    }
+}
+static void hashFinish(WebConfigSha256Context* ctx, uint8_t* digest) {
+    uint64_t bits = ctx->length * 8;
+    uint8_t pad = 0x80;
+    hashUpdate(ctx, &pad, 1);
+    pad = 0;
+    while (ctx->length % 64 != 56) hashUpdate(ctx, &pad, 1);
+    for (int i = 7; i >= 0; i--) {
+        uint8_t b = (uint8_t)(bits >> (i * 8));
+        hashUpdate(ctx, &b, 1);
+    }
+    for (int i = 0; i < 32; i++) digest[i] = (uint8_t)(ctx->state[i / 4] >> (24 - (i % 4) * 8));
+}
+static void hashCopy(WebConfigSha256Context* dst, const WebConfigSha256Context* src) { *dst = *src; }
+static void hashFree(WebConfigSha256Context* ctx) { (void)ctx; }
+static void fillRandom(uint8_t* buffer, size_t len) { ESP.random(buffer, len); }
+#elif defined(ESP8266)
+static void hashInit(br_sha256_context* ctx) { br_sha256_init(ctx); }
+static void hashUpdate(br_sha256_context* ctx, const uint8_t* data, size_t len) { br_sha256_update(ctx, data, len); }
+static void hashFinish(br_sha256_context* ctx, uint8_t* digest) { br_sha256_out(ctx, digest); }
+static void hashCopy(br_sha256_context* dst, const br_sha256_context* src) { *dst = *src; }
+static void hashFree(br_sha256_context* ctx) { (void)ctx; }
+static void fillRandom(uint8_t* buffer, size_t len) { ESP.random(buffer, len); }
+#else
+static void hashInit(mbedtls_sha256_context* ctx) {
+    mbedtls_sha256_init(ctx);
+    #if MBEDTLS_VERSION_NUMBER < 0x03000000
+    mbedtls_sha256_starts_ret(ctx, 0);
+    #else
+    mbedtls_sha256_starts(ctx, 0);
+    #endif
+}
+static void hashUpdate(mbedtls_sha256_context* ctx, const uint8_t* data, size_t len) {
+    #if MBEDTLS_VERSION_NUMBER < 0x03000000
+    mbedtls_sha256_update_ret(ctx, data, len);
+    #else
+    mbedtls_sha256_update(ctx, data, len);
+    #endif
+}
+static void hashFinish(mbedtls_sha256_context* ctx, uint8_t* digest) {
+    #if MBEDTLS_VERSION_NUMBER < 0x03000000
+    mbedtls_sha256_finish_ret(ctx, digest);
+    #else
+    mbedtls_sha256_finish(ctx, digest);
+    #endif
+}
+static void hashCopy(mbedtls_sha256_context* dst, const mbedtls_sha256_context* src) {
+    mbedtls_sha256_init(dst);
+    mbedtls_sha256_clone(dst, src);
+}
+static void hashFree(mbedtls_sha256_context* ctx) { mbedtls_sha256_free(ctx); }
+static void fillRandom(uint8_t* buffer, size_t len) { esp_fill_random(buffer, len); }
+#endif
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// ===== SESSION =====
+
+WebConfigSession::WebConfigSession() {
+    timeout = WEBCONFIG_SESSION_TIMEOUT;
+    ready = false;
+}
+
+WebConfigSession::~WebConfigSession() {
+    if (ready) {
+        hashFree(&innerState);
+        hashFree(&outerState);
+    }
+}
+
+void WebConfigSession::begin() {
+    if (ready) {
+        hashFree(&innerState);
+        hashFree(&outerState);
+    }
+
+    // 256-bit key, zero padded to the SHA-256 block size
+    uint8_t key[64];
+    uint8_t pad[64];
+    memset(key, 0, sizeof(key));
+    fillRandom(key, 32);
+
+    for (size_t i = 0; i < sizeof(pad); i++) pad[i] = key[i] ^ 0x36;
+    hashInit(&innerState);
+    hashUpdate(&innerState, pad, sizeof(pad));
+
+    for (size_t i = 0; i < sizeof(pad); i++) pad[i] = key[i] ^ 0x5C;
+    hashInit(&outerState);
+    hashUpdate(&outerState, pad, sizeof(pad));
+
+    memset(key, 0, sizeof(key));
+    memset(pad, 0, sizeof(pad));
+    ready = true;
+}
+
+void WebConfigSession::revoke() {
+    if (ready) begin();
+}
+
+void WebConfigSession::setTimeout(uint32_t seconds) {
+    if (seconds == 0) seconds = WEBCONFIG_SESSION_TIMEOUT;
+    if (seconds > WEBCONFIG_SESSION_MAX_TIMEOUT) seconds = WEBCONFIG_SESSION_MAX_TIMEOUT;
+    timeout = seconds;
+}
+
+void WebConfigSession::sign(uint32_t expiry, uint8_t* mac) {
+    uint8_t message[4] = {
+        (uint8_t)(expiry >> 24), (uint8_t)(expiry >> 16), (uint8_t)(expiry >> 8), (uint8_t)expiry
+    };
+    uint8_t digest[32];
+    HashContext ctx;
+
+    hashCopy(&ctx, &innerState);
+    hashUpdate(&ctx, message, sizeof(message));
+    hashFinish(&ctx, digest);
+    hashFree(&ctx);
+
+    hashCopy(&ctx, &outerState);
+    hashUpdate(&ctx, digest, sizeof(digest));
+    hashFinish(&ctx, digest);
+    hashFree(&ctx);
+
+    memcpy(mac, digest, WEBCONFIG_SESSION_MAC_LEN);
+}
+
+size_t WebConfigSession::issueCookie(char* buffer, size_t size) {
+    if (size == 0) return 0;
+    // The secret is made on the first login, when WiFi is up and the
+    // hardware RNG is seeded by the radio
+    if (!ready) begin();
+
+    // Expiry in millis() units; signed difference keeps it valid across the 49-day wrap
+    uint32_t expiry = millis() + timeout * 1000UL;
+    uint8_t mac[WEBCONFIG_SESSION_MAC_LEN];
+    sign(expiry, mac);
+
+    char token[WEBCONFIG_SESSION_TOKEN_LEN + 1];
+    snprintf(token, sizeof(token), "%08lx", (unsigned long)expiry);
+    for (size_t i = 0; i < WEBCONFIG_SESSION_MAC_LEN; i++) {
+        snprintf(token + 8 + i * 2, 3, "%02x", mac[i]);
+    }
+
+    int len = snprintf(buffer, size, WEBCONFIG_SESSION_COOKIE "=%s; Path=/; HttpOnly; SameSite=Strict; Max-Age=%lu",
+                       token, (unsigned long)timeout);
+    return (len > 0 && (size_t)len < size) ? len : 0;
+}
+
+bool WebConfigSession::verifyCookieHeader(const char* cookieHeader) {
+    if (!ready || !cookieHeader) return false;
+
+    // Locate our cookie as a whole name, not a suffix of another one
+    const size_t nameLen = sizeof(WEBCONFIG_SESSION_COOKIE) - 1;
+    const char* p = cookieHeader;
+    while ((p = strstr(p, WEBCONFIG_SESSION_COOKIE "=")) != nullptr) {
+        if (p == cookieHeader || p[-1] == ' ' || p[-1] == ';') break;
+        p += nameLen;
+    }
+    if (!p) return false;
+    p += nameLen + 1;
+
+    uint32_t expiry = 0;
+    for (int i = 0; i < 8; i++) {
+        int v = hexValue(p[i]);
+        if (v < 0) return false;
+        expiry = (expiry << 4) | v;
+    }
+
+    uint8_t given[WEBCONFIG_SESSION_MAC_LEN];
+    for (size_t i = 0; i < WEBCONFIG_SESSION_MAC_LEN; i++) {
+        int hi = hexValue(p[8 + i * 2]);
+        int lo = hexValue(p[9 + i * 2]);
+        if (hi < 0 || lo < 0) return false;
+        given[i] = (hi << 4) | lo;
+    }
+
+    char end = p[WEBCONFIG_SESSION_TOKEN_LEN];
+    if (end != '\0' && end != ';' && end != ' ') return false;
+
+    // Expired, or issued with a longer timeout than the current one
+    int32_t remaining = (int32_t)(expiry - millis());
+    if (remaining <= 0 || (uint32_t)remaining > timeout * 1000UL) return false;
+
+    uint8_t expected[WEBCONFIG_SESSION_MAC_LEN];
+    sign(expiry, expected);
+
+    // Constant-time compare
+    uint8_t diff = 0;
+    for (size_t i = 0; i < WEBCONFIG_SESSION_MAC_LEN; i++) {
+        diff |= given[i] ^ expected[i];
+    }
+    return diff == 0;
+}
+
+#endif // WEBCONFIG_ENABLE_AUTH
@@ -0,0 +1,74 @@
+/*
+ * ESP32WebConfig Library - Session Tokens
+ * HMAC-signed session cookies that replace per-request Basic auth checks
+ *
+ * Token format: <expiry:8 hex><mac:32 hex>, where mac is HMAC-SHA256 over
+ * the expiry (truncated to 16 bytes) keyed with a secret generated at boot.
+ * Rebooting therefore invalidates all sessions.
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGSESSION_H
+#define WEBCONFIGSESSION_H
+
+#include "WebConfigPlatform.h"
+
+#define WEBCONFIG_SESSION_COOKIE "WCSESSION"
+#define WEBCONFIG_SESSION_TIMEOUT 3600        // Default session lifetime in seconds
+#define WEBCONFIG_SESSION_MAX_TIMEOUT 604800  // 7 days, keeps millis() arithmetic wrap-safe
+#define WEBCONFIG_SESSION_MAC_LEN 16          // Truncated HMAC bytes carried in the token
+#define WEBCONFIG_SESSION_TOKEN_LEN (8 + WEBCONFIG_SESSION_MAC_LEN * 2)
+#define WEBCONFIG_SESSION_COOKIE_LEN 128      // Buffer size for a complete Set-Cookie value
+
+#if defined(WEBCONFIG_HOST)
+// State of the portable SHA-256 in WebConfigSession.cpp
+struct WebConfigSha256Context {
+    uint32_t state[8];
+    uint64_t length;    // Bytes absorbed so far
+    uint8_t block[64];
+};
+#endif
+
+class WebConfigSession {
+public:
+    WebConfigSession();
+    ~WebConfigSession();
+
+    // Generate a fresh secret; invalidates every issued token. Called by the
+    // first issueCookie() if not called before.
+    void begin();
+
+    // Invalidate every issued token; re-keys now if a secret exists,
+    // otherwise the next issueCookie() makes one as usual
+    void revoke();
+
+    void setTimeout(uint32_t seconds);
+    uint32_t getTimeout() const { return timeout; }
+
+    // Write a complete Set-Cookie value for a new session, returns its length
+    size_t issueCookie(char* buffer, size_t size);
+
+    // Check the raw Cookie request header; no heap allocation
+    bool verifyCookieHeader(const char* cookieHeader);
+
+private:
+#if defined(WEBCONFIG_HOST)
+    typedef WebConfigSha256Context HashContext;
+#elif defined(ESP8266)
+    typedef br_sha256_context HashContext;
+#else
+    typedef mbedtls_sha256_context HashContext;
+#endif
+
+    // Hash states after absorbing key^ipad and key^opad, so each MAC costs two compressions
+    HashContext innerState;
+    HashContext outerState;
+    uint32_t timeout;
+    bool ready;
+
+    void sign(uint32_t expiry, uint8_t* mac);
+};
+
+#endif // WEBCONFIGSESSION_H
@@ -0,0 +1,172 @@
+/*
+ * ESP32WebConfig Library - Event Trace Implementation
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#include "WebConfigTrace.h"
+
+static_assert(sizeof(WebConfigTrace::Event) == 8, "Trace events must stay 8 bytes");
+static_assert((WEBCONFIG_TRACE_EVENTS & (WEBCONFIG_TRACE_EVENTS - 1)) == 0, "WEBCONFIG_TRACE_EVENTS must be a power of two");
+static_assert(TRACE_ID_COUNT <= 255, "Trace ids must fit in one byte");
+
+static const char* const TRACE_NAMES[TRACE_ID_COUNT - METRIC_COUNT] = {
+    "handle_client", "dns", "log_drain", "json_serialize", "json_parse", "eeprom_read",
+    "eeprom_commit", "cb_change", "cb_save", "cb_load", "cb_validator", "wifi_event"
+};
+
+#if WEBCONFIG_TRACE_EVENTS
+WebConfigTrace::Event WebConfigTrace::events[WEBCONFIG_TRACE_EVENTS];
+#endif
+WebConfigTrace::Counter WebConfigTrace::head(0);
+volatile bool WebConfigTrace::enabled = true;
+
+// ===== RECORDING =====
+
+uint32_t WebConfigTrace::reserve(uint32_t count) {
+    #ifdef ESP8266
+    uint32_t seq = head;
+    head = seq + count;
+    return seq;
+    #else
+    return head.fetch_add(count);
+    #endif
+}
+
+void WebConfigTrace::record(uint8_t id, uint8_t phase, uint16_t arg) {
+    #if WEBCONFIG_TRACE_EVENTS
+    if (!enabled) return;
+
+    Event& event = events[reserve(1) & (WEBCONFIG_TRACE_EVENTS - 1)];
+    event.timestamp = micros();
+    event.id = id;
+    event.phase = phase;
+    event.arg = arg;
+    #endif
+}
+
+void WebConfigTrace::recordSpan(uint8_t id, uint32_t start) {
+    #if WEBCONFIG_TRACE_EVENTS
+    if (!enabled) return;
+
+    uint32_t seq = reserve(2);
+    Event& begin = events[seq & (WEBCONFIG_TRACE_EVENTS - 1)];
+    begin.timestamp = start;
+    begin.id = id;
+    begin.phase = TRACE_PHASE_BEGIN;
+    begin.arg = 0;
+
+    Event& end = events[(seq + 1) & (WEBCONFIG_TRACE_EVENTS - 1)];
+    end.timestamp = micros();
+    end.id = id;
+    end.phase = TRACE_PHASE_END;
+    end.arg = 0;
+    #endif
+}
+
+void WebConfigTrace::clear() {
+    head = 0;
+}
+
+uint32_t WebConfigTrace::getDropped() {
+    uint32_t recorded = head;
+    return recorded > WEBCONFIG_TRACE_EVENTS ? recorded - WEBCONFIG_TRACE_EVENTS : 0;
+}
+
+const char* WebConfigTrace::getName(uint8_t id) {
+    if (id < METRIC_COUNT) return WebConfigMetrics::getName((WebConfigMetricId)id);
+    if (id < TRACE_ID_COUNT) return TRACE_NAMES[id - METRIC_COUNT];
+    return "unknown";
+}
+
+void WebConfigTrace::attachWiFiEvents() {
+    #if WEBCONFIG_TRACE_EVENTS
+    #ifdef ESP8266
+    // Handlers unsubscribe when destroyed, keep them for the lifetime of the program
+    static WiFiEventHandler handlers[4];
+    handlers[0] = WiFi.onSoftAPModeStationConnected([](const WiFiEventSoftAPModeStationConnected&) {
+        record(TRACE_WIFI_EVENT, TRACE_PHASE_INSTANT, WIFI_EVENT_SOFTAPMODE_STACONNECTED);
+    });
+    handlers[1] = WiFi.onSoftAPModeStationDisconnected([](const WiFiEventSoftAPModeStationDisconnected&) {
+        record(TRACE_WIFI_EVENT, TRACE_PHASE_INSTANT, WIFI_EVENT_SOFTAPMODE_STADISCONNECTED);
+    });
+    handlers[2] = WiFi.onStationModeGotIP([](const WiFiEventStationModeGotIP&) {
+        record(TRACE_WIFI_EVENT, TRACE_PHASE_INSTANT, WIFI_EVENT_STAMODE_GOT_IP);
+    });
+    handlers[3] = WiFi.onStationModeDisconnected([](const WiFiEventStationModeDisconnected&) {
+        record(TRACE_WIFI_EVENT, TRACE_PHASE_INSTANT, WIFI_EVENT_STAMODE_DISCONNECTED);
+    });
+    #else
+    // arg is the core's event id
+    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
+        (void)info;
+        record(TRACE_WIFI_EVENT, TRACE_PHASE_INSTANT, (uint16_t)event);
+    });
+    #endif
+    #endif
+}
+
+// ===== DUMP =====
+
+size_t WebConfigTrace::send(WebServer& server) {
+    #if WEBCONFIG_TRACE_EVENTS
+    // Pause recording so the snapshot is not overwritten while streaming
+    bool wasEnabled = enabled;
+    enabled = false;
+
+    uint32_t end = head;
+    uint32_t count = end < WEBCONFIG_TRACE_EVENTS ? end : WEBCONFIG_TRACE_EVENTS;
+    uint32_t dropped = end - count;
+    #else
+    uint32_t count = 0;
+    uint32_t dropped = 0;
+    #endif
+
+    size_t namesSize = 0;
+    for (uint8_t id = 0; id < TRACE_ID_COUNT; id++) {
+        namesSize += 1 + strlen(getName(id));
+    }
+    size_t total = 16 + namesSize + count * sizeof(Event);
+
+    uint8_t buffer[512];
+    memcpy(buffer, "WCTR", 4);
+    buffer[4] = WEBCONFIG_TRACE_VERSION;
+    buffer[5] = sizeof(Event);
+    uint16_t nameCount = TRACE_ID_COUNT;
+    memcpy(buffer + 6, &nameCount, 2);
+    memcpy(buffer + 8, &count, 4);
+    memcpy(buffer + 12, &dropped, 4);
+    size_t used = 16;
+
+    server.setContentLength(total);
+    server.send(200, "application/octet-stream", "");
+
+    for (uint8_t id = 0; id < TRACE_ID_COUNT; id++) {
+        const char* name = getName(id);
+        size_t length = strlen(name);
+        if (used + 1 + length > sizeof(buffer)) {
+            server.sendContent((const char*)buffer, used);
+            used = 0;
+        }
+        buffer[used++] = length;
+        memcpy(buffer + used, name, length);
+        used += length;
+    }
+
+    #if WEBCONFIG_TRACE_EVENTS
+    // Oldest event first
+    for (uint32_t seq = end - count; seq != end; seq++) {
+        if (used + sizeof(Event) > sizeof(buffer)) {
+            server.sendContent((const char*)buffer, used);
+            used = 0;
+        }
+        memcpy(buffer + used, &events[seq & (WEBCONFIG_TRACE_EVENTS - 1)], sizeof(Event));
+        used += sizeof(Event);
+    }
+    enabled = wasEnabled;
+    #endif
+
+    if (used) server.sendContent((const char*)buffer, used);
+    return total;
+}
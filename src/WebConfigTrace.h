@@ -0,0 +1,143 @@
+/*
+ * ESP32WebConfig Library - Event Trace
+ * Fixed ring of 8-byte timestamped begin/end events for handlers,
+ * persistence, callbacks and WiFi, downloadable from /api/trace
+ *
+ * Binary dump (little endian):
+ *   "WCTR", uint8 version, uint8 event size, uint16 name count,
+ *   uint32 event count, uint32 dropped events,
+ *   name count x (uint8 length, chars),
+ *   event count x (uint32 micros, uint8 id, uint8 phase, uint16 arg)
+ *
+ * Author: ZONIO Project Team
+ * License: MIT
+ */
+
+#ifndef WEBCONFIGTRACE_H
+#define WEBCONFIGTRACE_H
+
+#include "WebConfigPlatform.h"
+#include "WebConfigMetrics.h"
+
+#ifndef ESP8266
+#include <atomic>
+#endif
+
+// Ring size in events (power of two), 0 compiles tracing out
+#ifndef WEBCONFIG_TRACE_EVENTS
+  #ifdef ESP8266
+  #define WEBCONFIG_TRACE_EVENTS 128
+  #else
+  #define WEBCONFIG_TRACE_EVENTS 512
+  #endif
+#endif
+
+#define WEBCONFIG_TRACE_VERSION 1
+
+// Loop-level spans (handle, handleClient, DNS) shorter than this are not
+// recorded, otherwise idle loop() passes would flush the ring in milliseconds
+#ifndef WEBCONFIG_TRACE_MIN_SPAN_US
+#define WEBCONFIG_TRACE_MIN_SPAN_US 200
+#endif
+
+// Event phases, same letters as the Chrome trace format
+#define TRACE_PHASE_BEGIN   'B'
+#define TRACE_PHASE_END     'E'
+#define TRACE_PHASE_INSTANT 'i'
+
+// Event ids; handler and operation spans reuse the WebConfigMetricId values
+enum WebConfigTraceId {
+    TRACE_HANDLE_CLIENT = METRIC_COUNT,
+    TRACE_DNS,
+    TRACE_LOG_DRAIN,
+    TRACE_JSON_SERIALIZE,
+    TRACE_JSON_PARSE,
+    TRACE_EEPROM_READ,
+    TRACE_EEPROM_COMMIT,
+    TRACE_CALLBACK_CHANGE,
+    TRACE_CALLBACK_SAVE,
+    TRACE_CALLBACK_LOAD,
+    TRACE_CALLBACK_VALIDATOR,
+    TRACE_WIFI_EVENT,
+    TRACE_ID_COUNT
+};
+
+#if WEBCONFIG_TRACE_EVENTS
+  #define WC_TRACE_CONCAT2(a, b) a##b
+  #define WC_TRACE_CONCAT(a, b) WC_TRACE_CONCAT2(a, b)
+  #define WC_TRACE_SCOPE(id) WebConfigTrace::Span WC_TRACE_CONCAT(_wcTraceSpan, __LINE__)(id)
+  #define WC_TRACE_SLOW_SCOPE(id) WebConfigTrace::SlowSpan WC_TRACE_CONCAT(_wcTraceSpan, __LINE__)(id)
+  #define WC_TRACE_INSTANT(id, arg) WebConfigTrace::record(id, TRACE_PHASE_INSTANT, arg)
+#else
+  #define WC_TRACE_SCOPE(id) do {} while (0)
+  #define WC_TRACE_SLOW_SCOPE(id) do {} while (0)
+  #define WC_TRACE_INSTANT(id, arg) do {} while (0)
+#endif
+
+class WebConfigTrace {
+public:
+    struct Event {
+        uint32_t timestamp;     // micros()
+        uint8_t id;
+        uint8_t phase;
+        uint16_t arg;
+    };
+
+    // Begin on construction, end on destruction
+    class Span {
+    public:
+        explicit Span(uint8_t id) : id(id) { WebConfigTrace::record(id, TRACE_PHASE_BEGIN); }
+        ~Span() { WebConfigTrace::record(id, TRACE_PHASE_END); }
+    private:
+        uint8_t id;
+    };
+
+    // Recorded only if it lasted at least WEBCONFIG_TRACE_MIN_SPAN_US
+    class SlowSpan {
+    public:
+        explicit SlowSpan(uint8_t id) : id(id), start(micros()) {}
+        ~SlowSpan() {
+            if (micros() - start >= WEBCONFIG_TRACE_MIN_SPAN_US) WebConfigTrace::recordSpan(id, start);
+        }
+    private:
+        uint8_t id;
+        uint32_t start;
+    };
+
+    static void setEnabled(bool enable) { enabled = enable; }
+    static bool isEnabled() { return enabled; }
+
+    // Append one event, never blocks or allocates
+    static void record(uint8_t id, uint8_t phase, uint16_t arg = 0);
+
+    // Append a begin/end pair after the fact; nested events precede it in the ring
+    static void recordSpan(uint8_t id, uint32_t start);
+    static void clear();
+
+    // Record WiFi and softAP station events as instants
+    static void attachWiFiEvents();
+
+    // Stream the binary dump as the body of the current response
+    static size_t send(WebServer& server);
+
+    static const char* getName(uint8_t id);
+    static uint32_t getDropped();
+
+private:
+    #ifdef ESP8266
+    // Single core and no tracing from interrupts, plain counters are enough
+    typedef volatile uint32_t Counter;
+    #else
+    typedef std::atomic<uint32_t> Counter;
+    #endif
+
+    #if WEBCONFIG_TRACE_EVENTS
+    static Event events[WEBCONFIG_TRACE_EVENTS];
+    #endif
+    static Counter head;
+    static volatile bool enabled;
+
+    static uint32_t reserve(uint32_t count);
+};
+
+#endif // WEBCONFIGTRACE_H
@@ -6,6 +6,10 @@
  * License: MIT
  */
 
+#include "WebConfigFeatures.h"
+
+#if WEBCONFIG_ENABLE_PAGES
+
 #include "WebPages.h"
 
 String WebPages::getHTMLHeader(const String& title) {
@@ -878,4 +882,6 @@ String WebPages::buildStatusGrid() {
             </div>
         </div>
     )";
-}
\ No newline at end of file
+}
+
+#endif // WEBCONFIG_ENABLE_PAGES
@@ -8,7 +8,10 @@
 
 #include "ZonioMinimalConfig.h"
 
-ZonioMinimalConfig::ZonioMinimalConfig() {
+ZonioMinimalConfigBase::ZonioMinimalConfigBase(ZonioParamInfo* params, char* values, char* defaults, char* options, char* page,
+                                               uint8_t maxParams, uint8_t valueLen, uint16_t optionsLen, uint16_t pageLen)
+    : params(params), values(values), defaults(defaults), options(options), page(page),
+      maxParams(maxParams), valueLen(valueLen), optionsLen(optionsLen), pageLen(pageLen) {
     server = nullptr;
     dnsServer = nullptr;
     paramCount = 0;
@@ -24,95 +27,124 @@ ZonioMinimalConfig::ZonioMinimalConfig() {
     apIP = IPAddress(192, 168, 4, 1);
 }
 
-ZonioMinimalConfig::~ZonioMinimalConfig() {
+ZonioMinimalConfigBase::~ZonioMinimalConfigBase() {
     if (server) delete server;
     if (dnsServer) delete dnsServer;
 }
 
-void ZonioMinimalConfig::setDeviceName(const char* name) {
+void ZonioMinimalConfigBase::setDeviceName(const char* name) {
     strncpy(deviceName, name, sizeof(deviceName) - 1);
     deviceName[sizeof(deviceName) - 1] = '\0';
 }
 
-void ZonioMinimalConfig::setAPCredentials(const char* ssid, const char* password) {
+void ZonioMinimalConfigBase::setAPCredentials(const char* ssid, const char* password) {
     strncpy(apSSID, ssid, sizeof(apSSID) - 1);
     strncpy(apPassword, password, sizeof(apPassword) - 1);
     apSSID[sizeof(apSSID) - 1] = '\0';
     apPassword[sizeof(apPassword) - 1] = '\0';
 }
 
-void ZonioMinimalConfig::setAPIP(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+void ZonioMinimalConfigBase::setAPIP(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
     apIP = IPAddress(a, b, c, d);
 }
 
-void ZonioMinimalConfig::addParameter(const char* key, const char* label, const char* defaultValue, ZonioParamType type) {
-    if (paramCount >= ZONIO_MAX_PARAMS) return;
+// FNV-1a folded to 16 bits; records are matched by key hash and type
+static uint16_t zonioKeyHash(const char* key) {
+    uint32_t hash = 0x811C9DC5;
+    while (*key) {
+        hash = (hash ^ (uint8_t)*key++) * 16777619u;
+    }
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+// EEPROM records carry only the key hash, so two keys with one hash would
+// overwrite each other; such a key is refused here
+bool ZonioMinimalConfigBase::addParameter(const char* key, const char* label, const char* defaultValue, ZonioParamType type) {
+    if (paramCount >= maxParams) {
+        Serial.print("Too many parameters, ignoring ");
+        Serial.println(key);
+        return false;
+    }
     
-    ZonioParam* param = &params[paramCount];
+    ZonioParamInfo* param = &params[paramCount];
     strncpy(param->key, key, sizeof(param->key) - 1);
+    param->key[sizeof(param->key) - 1] = '\0';
+    uint16_t hash = zonioKeyHash(param->key);
+    for (int i = 0; i < paramCount; i++) {
+        if (zonioKeyHash(params[i].key) == hash) {
+            Serial.print("Parameter key ");
+            Serial.print(param->key);
+            Serial.print(" has the same EEPROM hash as ");
+            Serial.print(params[i].key);
+            Serial.println(", rename one of them");
+            return false;
+        }
+    }
+    
+    char* value = valueAt(paramCount);
+    char* defaultCopy = defaults + paramCount * valueLen;
     strncpy(param->label, label, sizeof(param->label) - 1);
-    strncpy(param->value, defaultValue, sizeof(param->value) - 1);
-    strncpy(param->defaultValue, defaultValue, sizeof(param->defaultValue) - 1);
+    strncpy(value, defaultValue, valueLen - 1);
+    strncpy(defaultCopy, defaultValue, valueLen - 1);
     param->type = type;
     param->minValue = 0;
     param->maxValue = 100;
-    param->options[0] = '\0';
+    options[paramCount * optionsLen] = '\0';
     
-    param->key[sizeof(param->key) - 1] = '\0';
     param->label[sizeof(param->label) - 1] = '\0';
-    param->value[sizeof(param->value) - 1] = '\0';
-    param->defaultValue[sizeof(param->defaultValue) - 1] = '\0';
+    value[valueLen - 1] = '\0';
+    defaultCopy[valueLen - 1] = '\0';
     
     paramCount++;
+    return true;
 }
 
-void ZonioMinimalConfig::addNumberParameter(const char* key, const char* label, int defaultValue, int minVal, int maxVal) {
-    addParameter(key, label, String(defaultValue).c_str(), ZONIO_NUMBER);
-    if (paramCount > 0) {
+void ZonioMinimalConfigBase::addNumberParameter(const char* key, const char* label, int defaultValue, int minVal, int maxVal) {
+    if (addParameter(key, label, String(defaultValue).c_str(), ZONIO_NUMBER)) {
         params[paramCount - 1].minValue = minVal;
         params[paramCount - 1].maxValue = maxVal;
     }
 }
 
-void ZonioMinimalConfig::addFloatParameter(const char* key, const char* label, float defaultValue) {
+void ZonioMinimalConfigBase::addFloatParameter(const char* key, const char* label, float defaultValue) {
     addParameter(key, label, String(defaultValue, 2).c_str(), ZONIO_FLOAT);
 }
 
-void ZonioMinimalConfig::addCheckboxParameter(const char* key, const char* label, bool defaultValue) {
+void ZonioMinimalConfigBase::addCheckboxParameter(const char* key, const char* label, bool defaultValue) {
     addParameter(key, label, defaultValue ? "true" : "false", ZONIO_CHECKBOX);
 }
 
-void ZonioMinimalConfig::addSelectParameter(const char* key, const char* label, const char* options, const char* defaultValue) {
-    addParameter(key, label, defaultValue, ZONIO_SELECT);
-    if (paramCount > 0) {
-        strncpy(params[paramCount - 1].options, options, sizeof(params[paramCount - 1].options) - 1);
-        params[paramCount - 1].options[sizeof(params[paramCount - 1].options) - 1] = '\0';
+void ZonioMinimalConfigBase::addSelectParameter(const char* key, const char* label, const char* options, const char* defaultValue) {
+    if (addParameter(key, label, defaultValue, ZONIO_SELECT)) {
+        char* target = this->options + (paramCount - 1) * optionsLen;
+        strncpy(target, options, optionsLen - 1);
+        target[optionsLen - 1] = '\0';
     }
 }
 
-const char* ZonioMinimalConfig::getString(const char* key) {
+const char* ZonioMinimalConfigBase::getString(const char* key) {
     for (int i = 0; i < paramCount; i++) {
         if (strcmp(params[i].key, key) == 0) {
-            return params[i].value;
+            return valueAt(i);
         }
     }
     return "";
 }
 
-int ZonioMinimalConfig::getInt(const char* key) {
+int ZonioMinimalConfigBase::getInt(const char* key) {
     return atoi(getString(key));
 }
 
-float ZonioMinimalConfig::getFloat(const char* key) {
+float ZonioMinimalConfigBase::getFloat(const char* key) {
     return atof(getString(key));
 }
 
-bool ZonioMinimalConfig::getBool(const char* key) {
+bool ZonioMinimalConfigBase::getBool(const char* key) {
     const char* value = getString(key);
     return strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
 }
 
-void ZonioMinimalConfig::begin() {
+void ZonioMinimalConfigBase::begin() {
     #ifdef ESP8266
     EEPROM.begin(ZONIO_EEPROM_SIZE);
     #else
@@ -152,7 +184,7 @@ void ZonioMinimalConfig::begin() {
     Serial.println("Configuration timeout: 5 minutes");
 }
 
-void ZonioMinimalConfig::handle() {
+void ZonioMinimalConfigBase::handle() {
     if (!apActive) return;
     
     server->handleClient();
@@ -183,27 +215,66 @@ void ZonioMinimalConfig::handle() {
     }
 }
 
-void ZonioMinimalConfig::saveConfig() {
-    // Write magic number and version
+// ===== EEPROM STORAGE =====
+
+// CRC-16/CCITT-FALSE, bitwise to keep flash usage down
+static uint16_t zonioCrc16(uint16_t crc, uint8_t data) {
+    crc ^= (uint16_t)data << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static void zonioWriteByte(int& addr, uint8_t value, uint16_t& crc) {
+    EEPROM.write(addr++, value);
+    crc = zonioCrc16(crc, value);
+}
+
+void ZonioMinimalConfigBase::saveConfig() {
+    // Size of the packed records, checked before anything is overwritten
+    int length = 0;
+    for (int i = 0; i < paramCount; i++) {
+        length += ZONIO_RECORD_HEADER + strlen(valueAt(i));
+    }
+    if (ZONIO_EEPROM_HEADER + length > ZONIO_EEPROM_SIZE) {
+        Serial.println("Configuration too large for EEPROM");
+        return;
+    }
+    
+    // Write records; only the value bytes of each parameter are stored
+    int addr = ZONIO_EEPROM_HEADER;
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < paramCount; i++) {
+        uint16_t hash = zonioKeyHash(params[i].key);
+        const char* value = valueAt(i);
+        uint8_t valueLength = strlen(value);
+        zonioWriteByte(addr, hash & 0xFF, crc);
+        zonioWriteByte(addr, hash >> 8, crc);
+        zonioWriteByte(addr, params[i].type, crc);
+        zonioWriteByte(addr, valueLength, crc);
+        for (uint8_t j = 0; j < valueLength; j++) {
+            zonioWriteByte(addr, value[j], crc);
+        }
+    }
+    
+    // Write magic number, version and the record summary
     EEPROM.write(0, (ZONIO_MAGIC_NUMBER >> 24) & 0xFF);
     EEPROM.write(1, (ZONIO_MAGIC_NUMBER >> 16) & 0xFF);
     EEPROM.write(2, (ZONIO_MAGIC_NUMBER >> 8) & 0xFF);
     EEPROM.write(3, ZONIO_MAGIC_NUMBER & 0xFF);
     EEPROM.write(4, ZONIO_CONFIG_VERSION);
     EEPROM.write(5, paramCount);
-    
-    // Write parameters
-    int addr = 6;
-    for (int i = 0; i < paramCount; i++) {
-        EEPROM.put(addr, params[i]);
-        addr += sizeof(ZonioParam);
-    }
+    EEPROM.write(6, length & 0xFF);
+    EEPROM.write(7, length >> 8);
+    EEPROM.write(8, crc & 0xFF);
+    EEPROM.write(9, crc >> 8);
     
     EEPROM.commit();
     Serial.println("Configuration saved to EEPROM");
 }
 
-bool ZonioMinimalConfig::loadConfig() {
+bool ZonioMinimalConfigBase::loadConfig() {
     // Check magic number
     uint32_t magic = 0;
     magic |= (uint32_t)EEPROM.read(0) << 24;
@@ -216,30 +287,82 @@ bool ZonioMinimalConfig::loadConfig() {
         return false;
     }
     
+    // Records of parameters this firmware does not have are skipped
+    int savedParamCount = EEPROM.read(5);
+    
     // Check version
-    if (EEPROM.read(4) != ZONIO_CONFIG_VERSION) {
+    uint8_t version = EEPROM.read(4);
+    if (version == ZONIO_CONFIG_VERSION_LEGACY) {
+        return loadLegacyConfig(savedParamCount);
+    }
+    if (version != ZONIO_CONFIG_VERSION) {
         Serial.println("Invalid config version");
         return false;
     }
     
-    // Read parameter count
-    int savedParamCount = EEPROM.read(5);
-    if (savedParamCount > ZONIO_MAX_PARAMS) {
-        Serial.println("Too many parameters in EEPROM");
+    // Verify the records before applying any of them
+    int length = EEPROM.read(6) | (EEPROM.read(7) << 8);
+    uint16_t savedCrc = EEPROM.read(8) | (EEPROM.read(9) << 8);
+    if (ZONIO_EEPROM_HEADER + length > ZONIO_EEPROM_SIZE) {
+        Serial.println("Invalid config length");
+        return false;
+    }
+    
+    uint16_t crc = 0xFFFF;
+    for (int addr = ZONIO_EEPROM_HEADER; addr < ZONIO_EEPROM_HEADER + length; addr++) {
+        crc = zonioCrc16(crc, EEPROM.read(addr));
+    }
+    if (crc != savedCrc) {
+        Serial.println("Config CRC mismatch");
         return false;
     }
     
-    // Read parameters
+    // Read records
+    int addr = ZONIO_EEPROM_HEADER;
+    int end = ZONIO_EEPROM_HEADER + length;
+    for (int i = 0; i < savedParamCount && addr + ZONIO_RECORD_HEADER <= end; i++) {
+        uint16_t hash = EEPROM.read(addr) | (EEPROM.read(addr + 1) << 8);
+        uint8_t type = EEPROM.read(addr + 2);
+        uint8_t valueLength = EEPROM.read(addr + 3);
+        addr += ZONIO_RECORD_HEADER;
+        if (addr + valueLength > end) break;
+        
+        // Find matching parameter by key hash and type
+        for (int j = 0; j < paramCount; j++) {
+            if (params[j].type == type && zonioKeyHash(params[j].key) == hash) {
+                char* value = valueAt(j);
+                uint8_t copyLength = valueLength < valueLen - 1 ? valueLength : valueLen - 1;
+                for (uint8_t k = 0; k < copyLength; k++) {
+                    value[k] = EEPROM.read(addr + k);
+                }
+                value[copyLength] = '\0';
+                break;
+            }
+        }
+        
+        addr += valueLength;
+    }
+    
+    Serial.println("Configuration loaded from EEPROM");
+    return true;
+}
+
+// Version 1 stored whole ZonioParam structs; read once, the next save
+// rewrites the packed layout
+bool ZonioMinimalConfigBase::loadLegacyConfig(int savedParamCount) {
     int addr = 6;
-    for (int i = 0; i < savedParamCount && i < paramCount; i++) {
+    for (int i = 0; i < savedParamCount && addr + (int)sizeof(ZonioParam) <= ZONIO_EEPROM_SIZE; i++) {
         ZonioParam savedParam;
         EEPROM.get(addr, savedParam);
+        savedParam.key[sizeof(savedParam.key) - 1] = '\0';
         
         // Find matching parameter by key
         for (int j = 0; j < paramCount; j++) {
             if (strcmp(params[j].key, savedParam.key) == 0) {
-                strncpy(params[j].value, savedParam.value, sizeof(params[j].value) - 1);
-                params[j].value[sizeof(params[j].value) - 1] = '\0';
+                char* value = valueAt(j);
+                savedParam.value[sizeof(savedParam.value) - 1] = '\0';
+                strncpy(value, savedParam.value, valueLen - 1);
+                value[valueLen - 1] = '\0';
                 break;
             }
         }
@@ -247,11 +370,11 @@ bool ZonioMinimalConfig::loadConfig() {
         addr += sizeof(ZonioParam);
     }
     
-    Serial.println("Configuration loaded from EEPROM");
+    Serial.println("Legacy configuration loaded from EEPROM");
     return true;
 }
 
-void ZonioMinimalConfig::generateHTML(char* buffer, size_t bufferSize) {
+void ZonioMinimalConfigBase::generateHTML(char* buffer, size_t bufferSize) {
     snprintf(buffer, bufferSize,
         "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>%s</title><style>"
         "body{font-family:Arial,sans-serif;margin:0;padding:20px;background:#f0f0f0}"
@@ -271,38 +394,39 @@ void ZonioMinimalConfig::generateHTML(char* buffer, size_t bufferSize) {
     // Add form fields
     for (int i = 0; i < paramCount; i++) {
         char fieldHTML[256];
-        ZonioParam* param = &params[i];
+        ZonioParamInfo* param = &params[i];
+        const char* value = valueAt(i);
         
         switch (param->type) {
             case ZONIO_TEXT:
                 snprintf(fieldHTML, sizeof(fieldHTML),
                     "<div class='form-group'><label>%s</label><input type='text' name='%s' value='%s'></div>",
-                    param->label, param->key, param->value);
+                    param->label, param->key, value);
                 break;
                 
             case ZONIO_NUMBER:
                 snprintf(fieldHTML, sizeof(fieldHTML),
                     "<div class='form-group'><label>%s</label><input type='number' name='%s' value='%s' min='%d' max='%d'></div>",
-                    param->label, param->key, param->value, param->minValue, param->maxValue);
+                    param->label, param->key, value, param->minValue, param->maxValue);
                 break;
                 
             case ZONIO_FLOAT:
                 snprintf(fieldHTML, sizeof(fieldHTML),
                     "<div class='form-group'><label>%s</label><input type='number' name='%s' value='%s' step='0.1'></div>",
-                    param->label, param->key, param->value);
+                    param->label, param->key, value);
                 break;
                 
             case ZONIO_CHECKBOX:
                 snprintf(fieldHTML, sizeof(fieldHTML),
                     "<div class='form-group'><div class='checkbox-group'><input type='checkbox' name='%s' value='true'%s><label>%s</label></div></div>",
-                    param->key, (strcmp(param->value, "true") == 0) ? " checked" : "", param->label);
+                    param->key, (strcmp(value, "true") == 0) ? " checked" : "", param->label);
                 break;
                 
             case ZONIO_SELECT:
                 // Simple select implementation
                 snprintf(fieldHTML, sizeof(fieldHTML),
                     "<div class='form-group'><label>%s</label><select name='%s'><option value='%s'>%s</option></select></div>",
-                    param->label, param->key, param->value, param->value);
+                    param->label, param->key, value, value);
                 break;
         }
         
@@ -317,30 +441,30 @@ void ZonioMinimalConfig::generateHTML(char* buffer, size_t bufferSize) {
         bufferSize - strlen(buffer) - 1);
 }
 
-void ZonioMinimalConfig::handleRoot() {
-    static char htmlBuffer[2048];
-    generateHTML(htmlBuffer, sizeof(htmlBuffer));
-    server->send(200, "text/html", htmlBuffer);
+void ZonioMinimalConfigBase::handleRoot() {
+    generateHTML(page, pageLen);
+    server->send(200, "text/html", page);
 }
 
-void ZonioMinimalConfig::handleSave() {
+void ZonioMinimalConfigBase::handleSave() {
     // Process form data
     for (int i = 0; i < paramCount; i++) {
-        ZonioParam* param = &params[i];
+        ZonioParamInfo* param = &params[i];
+        char* value = valueAt(i);
         
         if (param->type == ZONIO_CHECKBOX) {
             // Checkbox handling
             if (server->hasArg(param->key)) {
-                strcpy(param->value, "true");
+                strcpy(value, "true");
             } else {
-                strcpy(param->value, "false");
+                strcpy(value, "false");
             }
         } else {
             // Other input types
             if (server->hasArg(param->key)) {
-                String value = server->arg(param->key);
-                strncpy(param->value, value.c_str(), sizeof(param->value) - 1);
-                param->value[sizeof(param->value) - 1] = '\0';
+                String arg = server->arg(param->key);
+                strncpy(value, arg.c_str(), valueLen - 1);
+                value[valueLen - 1] = '\0';
             }
         }
     }
@@ -382,7 +506,7 @@ void ZonioMinimalConfig::handleSave() {
     Serial.println("Configuration saved - AP mode stopped");
 }
 
-void ZonioMinimalConfig::handleNotFound() {
+void ZonioMinimalConfigBase::handleNotFound() {
     // Redirect to main page for captive portal
     server->sendHeader("Location", "http://" + apIP.toString(), true);
     server->send(302, "text/plain", "");
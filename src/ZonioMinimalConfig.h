@@ -9,34 +9,49 @@
  * - Single HTML page with inline CSS/JS
  * - EEPROM configuration storage
  * - Compatible across all Zonio firmware versions
+ *
+ * ZonioMinimalConfig uses the default capacity below. Products that need
+ * fewer or more parameters size the storage at compile time instead:
+ *
+ *   ZonioMinimalConfigT<4, 32> config;   // 4 parameters, 31-char values
+ *
+ * All logic lives in the non-template ZonioMinimalConfigBase, so each
+ * instantiation only adds its storage arrays and a constructor.
  */
 
 #ifndef ZONIO_MINIMAL_WEBCONFIG_H
 #define ZONIO_MINIMAL_WEBCONFIG_H
 
-#ifdef ESP8266
-  #include <ESP8266WiFi.h>
-  #include <ESP8266WebServer.h>
-  #include <DNSServer.h>
-  #include <EEPROM.h>
-  #define WebServer ESP8266WebServer
-  #define WiFi_Mode_t WiFiMode_t
-  #define WIFI_AP_STA WIFI_AP_STA
-  #define WIFI_AP WIFI_AP
-#else
-  #include <WiFi.h>
-  #include <WebServer.h>
-  #include <DNSServer.h>
-  #include <EEPROM.h>
-#endif
+#include "WebConfigPlatform.h"
 
 // Configuration constants
-#define ZONIO_CONFIG_VERSION 1
+#define ZONIO_CONFIG_VERSION 2
+#define ZONIO_CONFIG_VERSION_LEGACY 1  // Whole ZonioParam structs, read only
 #define ZONIO_MAGIC_NUMBER 0x5A4F4E49  // "ZONI" in hex
+#ifndef ZONIO_EEPROM_SIZE
 #define ZONIO_EEPROM_SIZE 512
-#define ZONIO_MAX_PARAMS 8
+#endif
 #define ZONIO_AP_TIMEOUT 300000  // 5 minutes
-#define ZONIO_PARAM_LEN 64
+
+// Default capacity of ZonioMinimalConfig
+#define ZONIO_MAX_PARAMS 8
+#define ZONIO_PARAM_LEN 64       // Value buffer, including the terminator
+#define ZONIO_OPTIONS_LEN 128    // Select options buffer
+#define ZONIO_PAGE_LEN 2048      // Configuration page buffer
+
+// When set, every instantiation must fit in ZONIO_EEPROM_SIZE with all
+// values at full length; otherwise only the record headers are checked and
+// saveConfig() rejects a configuration that does not fit at run time
+#ifndef ZONIO_STRICT_EEPROM_BUDGET
+#define ZONIO_STRICT_EEPROM_BUDGET 0
+#endif
+
+// Packed EEPROM layout (version 2):
+//   magic[4] version[1] count[1] length[2] crc16[2]
+//   count x { keyHash[2] type[1] valueLength[1] value[valueLength] }
+// length covers the records, the CRC-16/CCITT is taken over them
+#define ZONIO_EEPROM_HEADER 10
+#define ZONIO_RECORD_HEADER 4
 
 // Parameter types
 enum ZonioParamType {
@@ -47,7 +62,16 @@ enum ZonioParamType {
   ZONIO_SELECT
 };
 
-// Configuration parameter structure
+// Fixed-size part of a parameter, the buffers are sized by the template
+struct ZonioParamInfo {
+  char key[16];
+  char label[32];
+  ZonioParamType type;
+  int minValue;
+  int maxValue;
+};
+
+// Version 1 EEPROM record, only read to migrate old configurations
 struct ZonioParam {
   char key[16];
   char label[32];
@@ -59,8 +83,8 @@ struct ZonioParam {
   char options[128];  // JSON array for select
 };
 
-// Main configuration class
-class ZonioMinimalConfig {
+// Main configuration class, storage provided by ZonioMinimalConfigT
+class ZonioMinimalConfigBase {
 private:
   WebServer* server;
   DNSServer* dnsServer;
@@ -70,7 +94,16 @@ private:
   char apPassword[16];
   IPAddress apIP;
   
-  ZonioParam params[ZONIO_MAX_PARAMS];
+  // Storage of the derived template, maxParams entries each
+  ZonioParamInfo* params;
+  char* values;
+  char* defaults;
+  char* options;
+  char* page;
+  uint8_t maxParams;
+  uint8_t valueLen;
+  uint16_t optionsLen;
+  uint16_t pageLen;
   int paramCount;
   
   unsigned long apStartTime;
@@ -78,6 +111,8 @@ private:
   bool configMode;
   bool shouldRestart;
   
+  char* valueAt(int index) { return values + index * valueLen; }
+  
   // Minimal HTML template
   const char* getConfigPage();
   void handleRoot();
@@ -87,23 +122,30 @@ private:
   // EEPROM functions
   void saveConfig();
   bool loadConfig();
+  bool loadLegacyConfig(int savedParamCount);
   void clearConfig();
   
   // Utility functions
   bool isValidIP(const char* ip);
   void generateHTML(char* buffer, size_t bufferSize);
   
-public:
-  ZonioMinimalConfig();
-  ~ZonioMinimalConfig();
+  ZonioMinimalConfigBase(const ZonioMinimalConfigBase&);
+  ZonioMinimalConfigBase& operator=(const ZonioMinimalConfigBase&);
+  
+protected:
+  ZonioMinimalConfigBase(ZonioParamInfo* params, char* values, char* defaults, char* options, char* page,
+                         uint8_t maxParams, uint8_t valueLen, uint16_t optionsLen, uint16_t pageLen);
+  ~ZonioMinimalConfigBase();
   
+public:
   // Setup functions
   void setDeviceName(const char* name);
   void setAPCredentials(const char* ssid, const char* password);
   void setAPIP(uint8_t a, uint8_t b, uint8_t c, uint8_t d);
   
   // Parameter management
-  void addParameter(const char* key, const char* label, const char* defaultValue, ZonioParamType type = ZONIO_TEXT);
+  // False when the table is full or the key's EEPROM hash is already taken
+  bool addParameter(const char* key, const char* label, const char* defaultValue, ZonioParamType type = ZONIO_TEXT);
   void addNumberParameter(const char* key, const char* label, int defaultValue, int minVal = 0, int maxVal = 100);
   void addFloatParameter(const char* key, const char* label, float defaultValue);
   void addCheckboxParameter(const char* key, const char* label, bool defaultValue);
@@ -121,6 +163,47 @@ public:
   bool isConfigMode() { return configMode; }
   bool shouldRestartDevice() { return shouldRestart; }
   void markRestartHandled() { shouldRestart = false; }
+  int getParameterCount() const { return paramCount; }
+  int getMaxParameters() const { return maxParams; }
 };
 
+// MaxParams parameters with ValueLen-byte values (terminator included),
+// OptionsLen-byte select options and a PageLen-byte configuration page
+template <uint8_t MaxParams,
+          uint8_t ValueLen = ZONIO_PARAM_LEN,
+          uint16_t OptionsLen = ZONIO_OPTIONS_LEN,
+          uint16_t PageLen = ZONIO_PAGE_LEN>
+class ZonioMinimalConfigT : public ZonioMinimalConfigBase {
+public:
+  enum : uint16_t {
+    MAX_PARAMS = MaxParams,
+    // RAM per parameter
+    PARAM_BYTES = sizeof(ZonioParamInfo) + 2 * ValueLen + OptionsLen,
+    // EEPROM bytes with every value at full length
+    EEPROM_BYTES = ZONIO_EEPROM_HEADER + MaxParams * (ZONIO_RECORD_HEADER + ValueLen - 1)
+  };
+  
+  ZonioMinimalConfigT()
+    : ZonioMinimalConfigBase(paramInfo, paramValues[0], paramDefaults[0], paramOptions[0], pageBuffer,
+                             MaxParams, ValueLen, OptionsLen, PageLen) {}
+  
+private:
+  ZonioParamInfo paramInfo[MaxParams];
+  char paramValues[MaxParams][ValueLen];
+  char paramDefaults[MaxParams][ValueLen];
+  char paramOptions[MaxParams][OptionsLen];
+  char pageBuffer[PageLen];
+  
+  static_assert(MaxParams > 0, "ZonioMinimalConfigT needs at least one parameter");
+  static_assert(ValueLen >= 6, "ValueLen must hold \"false\" and the terminator");
+  static_assert(OptionsLen >= 1, "OptionsLen must be at least 1");
+  static_assert(PageLen >= 1024, "PageLen is too small for the configuration page");
+  static_assert(ZONIO_EEPROM_HEADER + MaxParams * ZONIO_RECORD_HEADER <= ZONIO_EEPROM_SIZE,
+                "Too many parameters for ZONIO_EEPROM_SIZE");
+  static_assert(!ZONIO_STRICT_EEPROM_BUDGET || EEPROM_BYTES <= ZONIO_EEPROM_SIZE,
+                "Parameters at full length exceed ZONIO_EEPROM_SIZE");
+};
+
+typedef ZonioMinimalConfigT<ZONIO_MAX_PARAMS> ZonioMinimalConfig;
+
 #endif // ZONIO_MINIMAL_WEBCONFIG_H
\ No newline at end of file